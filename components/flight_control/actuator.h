@@ -0,0 +1,18 @@
+#pragma once
+
+// Number of motors driven by the mixer (quad X)
+#define MOTOR_COUNT 4
+
+// Abstract motor output stage. The rate loop only talks to this interface so
+// the same controller runs against LEDC PWM on the target and against the
+// rigid-body simulator on the host.
+class Actuator {
+public:
+    virtual ~Actuator() = default;
+
+    // Apply normalized motor commands in [0, 1], ordered as in mixer.h.
+    virtual void write(const float motors[MOTOR_COUNT]) = 0;
+
+    // Cut all motor outputs.
+    virtual void disarm() = 0;
+};
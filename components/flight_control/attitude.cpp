@@ -0,0 +1,33 @@
+#include "attitude.h"
+
+#include <math.h>
+
+AttitudeEstimator::AttitudeEstimator() : angle{}, primed(false) {}
+
+void AttitudeEstimator::reset() {
+    angle[0] = angle[1] = angle[2] = 0.0f;
+    primed = false;
+}
+
+void AttitudeEstimator::update(const float accel[3], const float gyro[3], float dt) {
+    float accel_roll = atan2f(-accel[1], -accel[2]);
+    float accel_pitch = atan2f(accel[0], sqrtf(accel[1] * accel[1] + accel[2] * accel[2]));
+
+    // Start from the gravity vector rather than converging from zero
+    if (!primed) {
+        angle[0] = accel_roll;
+        angle[1] = accel_pitch;
+        primed = true;
+        return;
+    }
+
+    angle[0] = ATTITUDE_GYRO_WEIGHT * (angle[0] + gyro[0] * dt) + (1.0f - ATTITUDE_GYRO_WEIGHT) * accel_roll;
+    angle[1] = ATTITUDE_GYRO_WEIGHT * (angle[1] + gyro[1] * dt) + (1.0f - ATTITUDE_GYRO_WEIGHT) * accel_pitch;
+    angle[2] = remainderf(angle[2] + gyro[2] * dt, 2.0f * (float)M_PI);
+}
+
+void AttitudeEstimator::get(float attitude[3]) const {
+    for (int i = 0; i < 3; i++) {
+        attitude[i] = angle[i];
+    }
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+// Complementary filter weight on the integrated gyro path
+#define ATTITUDE_GYRO_WEIGHT 0.98f
+
+// Lightweight roll/pitch/yaw estimate for telemetry. Roll and pitch blend
+// integrated gyro with the accelerometer gravity vector; yaw is gyro only and
+// drifts. Accel (specific force, g) and gyro (rad/s) must both be in the FRD
+// body frame, so a level craft at rest reads accel (0, 0, -1).
+class AttitudeEstimator {
+private:
+    float angle[3];     // rad
+    bool primed;
+
+public:
+    AttitudeEstimator();
+
+    void reset();
+    void update(const float accel[3], const float gyro[3], float dt);
+    void get(float attitude[3]) const;
+};
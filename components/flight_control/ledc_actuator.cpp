@@ -0,0 +1,68 @@
+#include "ledc_actuator.h"
+#include "esp_log.h"
+
+static const char *TAG = "ledc_actuator";
+
+static const int motor_gpio[MOTOR_COUNT] = { MOTOR1_GPIO, MOTOR2_GPIO, MOTOR3_GPIO, MOTOR4_GPIO };
+static const uint32_t max_duty = (1u << MOTOR_PWM_RESOLUTION) - 1;
+
+// Constructor
+LedcActuator::LedcActuator() : initialized(false) {}
+
+// Destructor
+LedcActuator::~LedcActuator() {
+    disarm();
+}
+
+esp_err_t LedcActuator::init() {
+    ledc_timer_config_t timer_cfg = {};
+    timer_cfg.speed_mode = MOTOR_PWM_MODE;
+    timer_cfg.duty_resolution = MOTOR_PWM_RESOLUTION;
+    timer_cfg.timer_num = MOTOR_PWM_TIMER;
+    timer_cfg.freq_hz = MOTOR_PWM_FREQ_HZ;
+    timer_cfg.clk_cfg = LEDC_AUTO_CLK;
+
+    esp_err_t err = ledc_timer_config(&timer_cfg);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "LEDC timer config failed: %s", esp_err_to_name(err));
+        return err;
+    }
+
+    for (int i = 0; i < MOTOR_COUNT; i++) {
+        ledc_channel_config_t channel_cfg = {};
+        channel_cfg.gpio_num = motor_gpio[i];
+        channel_cfg.speed_mode = MOTOR_PWM_MODE;
+        channel_cfg.channel = (ledc_channel_t)i;
+        channel_cfg.timer_sel = MOTOR_PWM_TIMER;
+        channel_cfg.duty = 0;
+
+        err = ledc_channel_config(&channel_cfg);
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "LEDC channel %d config failed: %s", i, esp_err_to_name(err));
+            return err;
+        }
+    }
+
+    initialized = true;
+    ESP_LOGI(TAG, "Motor PWM initialized at %d Hz", MOTOR_PWM_FREQ_HZ);
+    return ESP_OK;
+}
+
+void LedcActuator::write(const float motors[MOTOR_COUNT]) {
+    if (!initialized) return;
+
+    for (int i = 0; i < MOTOR_COUNT; i++) {
+        float m = motors[i] < 0.0f ? 0.0f : (motors[i] > 1.0f ? 1.0f : motors[i]);
+        ledc_set_duty(MOTOR_PWM_MODE, (ledc_channel_t)i, (uint32_t)(m * max_duty));
+        ledc_update_duty(MOTOR_PWM_MODE, (ledc_channel_t)i);
+    }
+}
+
+void LedcActuator::disarm() {
+    if (!initialized) return;
+
+    for (int i = 0; i < MOTOR_COUNT; i++) {
+        ledc_set_duty(MOTOR_PWM_MODE, (ledc_channel_t)i, 0);
+        ledc_update_duty(MOTOR_PWM_MODE, (ledc_channel_t)i);
+    }
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "driver/ledc.h"
+#include "esp_err.h"
+
+#include "actuator.h"
+
+// Motor MOSFET gate pins, ordered as MotorIndex in mixer.h
+#define MOTOR1_GPIO             5
+#define MOTOR2_GPIO             17
+#define MOTOR3_GPIO             27
+#define MOTOR4_GPIO             26
+
+// Brushed motor PWM: 15 kHz keeps the switching noise above hearing
+#define MOTOR_PWM_FREQ_HZ       15000
+#define MOTOR_PWM_RESOLUTION    LEDC_TIMER_12_BIT
+#define MOTOR_PWM_TIMER         LEDC_TIMER_0
+#define MOTOR_PWM_MODE          LEDC_HIGH_SPEED_MODE
+
+// Drives brushed motors directly through LEDC duty cycle.
+class LedcActuator : public Actuator {
+private:
+    bool initialized;
+
+public:
+    LedcActuator();
+    ~LedcActuator();
+
+    esp_err_t init();
+    void write(const float motors[MOTOR_COUNT]) override;
+    void disarm() override;
+};
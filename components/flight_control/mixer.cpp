@@ -0,0 +1,35 @@
+#include "mixer.h"
+
+// Per-motor contribution of roll, pitch and yaw demand
+static const float MIXER_QUAD_X[MOTOR_COUNT][3] = {
+    // roll   pitch   yaw
+    { -1.0f,  1.0f,   1.0f },  // M1 front right (CCW)
+    { -1.0f, -1.0f,  -1.0f },  // M2 rear right (CW)
+    {  1.0f, -1.0f,   1.0f },  // M3 rear left (CCW)
+    {  1.0f,  1.0f,  -1.0f },  // M4 front left (CW)
+};
+
+void mixer_quad_x(float throttle, float roll, float pitch, float yaw,
+                  float motors[MOTOR_COUNT]) {
+    float min_out = 1.0f;
+    float max_out = 0.0f;
+
+    for (int i = 0; i < MOTOR_COUNT; i++) {
+        motors[i] = throttle + MIXER_QUAD_X[i][0] * roll + MIXER_QUAD_X[i][1] * pitch + MIXER_QUAD_X[i][2] * yaw;
+        if (motors[i] < min_out) min_out = motors[i];
+        if (motors[i] > max_out) max_out = motors[i];
+    }
+
+    // Shift the outputs back into range, then clamp whatever still does not fit
+    float shift = 0.0f;
+    if (max_out > 1.0f) {
+        shift = 1.0f - max_out;
+    } else if (min_out < 0.0f) {
+        shift = -min_out;
+    }
+
+    for (int i = 0; i < MOTOR_COUNT; i++) {
+        float m = motors[i] + shift;
+        motors[i] = m < 0.0f ? 0.0f : (m > 1.0f ? 1.0f : m);
+    }
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "actuator.h"
+
+// Quad X motor layout, viewed from above with the nose pointing forward:
+// M1 front right (CCW), M2 rear right (CW), M3 rear left (CCW), M4 front left (CW).
+//
+// Demands are torques about the FRD body axes (x forward, y right, z down):
+// positive roll lowers the right side, positive pitch raises the nose and
+// positive yaw turns the nose right. Gyro input must be in the same frame.
+enum MotorIndex {
+    MOTOR_FRONT_RIGHT = 0,
+    MOTOR_REAR_RIGHT  = 1,
+    MOTOR_REAR_LEFT   = 2,
+    MOTOR_FRONT_LEFT  = 3,
+};
+
+// Mixes collective throttle and per-axis torque demands into motor commands.
+// When a motor would saturate the whole output is shifted so the attitude
+// correction is preserved at the expense of collective thrust.
+void mixer_quad_x(float throttle, float roll, float pitch, float yaw,
+                  float motors[MOTOR_COUNT]);
@@ -0,0 +1,35 @@
+#include "pid.h"
+
+static float clampf(float v, float limit) {
+    if (v > limit) return limit;
+    if (v < -limit) return -limit;
+    return v;
+}
+
+Pid::Pid(const PidGains &gains) : gains(gains), integral(0.0f), prev_measurement(0.0f), primed(false) {}
+
+void Pid::set_gains(const PidGains &new_gains) {
+    gains = new_gains;
+}
+
+void Pid::reset() {
+    integral = 0.0f;
+    prev_measurement = 0.0f;
+    primed = false;
+}
+
+float Pid::update(float setpoint, float measurement, float dt) {
+    float error = setpoint - measurement;
+
+    integral = clampf(integral + gains.ki * error * dt, gains.i_limit);
+
+    // Derivative on measurement avoids kicks on setpoint steps
+    float derivative = 0.0f;
+    if (primed && dt > 0.0f) {
+        derivative = -(measurement - prev_measurement) / dt;
+    }
+    prev_measurement = measurement;
+    primed = true;
+
+    return clampf(gains.kp * error + integral + gains.kd * derivative, gains.out_limit);
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+struct PidGains {
+    float kp;
+    float ki;
+    float kd;
+    float i_limit;      // Absolute clamp on the integral contribution
+    float out_limit;    // Absolute clamp on the controller output
+};
+
+// Single-axis PID with derivative on measurement and integral clamping.
+class Pid {
+private:
+    PidGains gains;
+    float integral;
+    float prev_measurement;
+    bool primed;
+
+public:
+    Pid(const PidGains &gains = PidGains{});
+
+    void set_gains(const PidGains &gains);
+    void reset();
+    float update(float setpoint, float measurement, float dt);
+};
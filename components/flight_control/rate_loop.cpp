@@ -0,0 +1,167 @@
+#include "rate_loop.h"
+#include "mixer.h"
+
+RateLoop::RateLoop(Actuator *actuator, uint32_t period_us, uint32_t budget_us)
+    : actuator(actuator), period_us(period_us), budget_us(budget_us),
+      setpoint{}, armed(false), primed(false), last_sample_us(0), cycle_sample_us(0),
+      accounted_us(-1), lost_samples(0),
+      snapshot_state(SNAPSHOT_IDLE), snapshot{} {
+    pid[RATE_AXIS_ROLL].set_gains(PidGains RATE_PID_ROLL_DEFAULT);
+    pid[RATE_AXIS_PITCH].set_gains(PidGains RATE_PID_PITCH_DEFAULT);
+    pid[RATE_AXIS_YAW].set_gains(PidGains RATE_PID_YAW_DEFAULT);
+    reset_stats();
+}
+
+void RateLoop::set_gains(RateAxis axis, const PidGains &gains) {
+    pid[axis].set_gains(gains);
+}
+
+void RateLoop::set_setpoint(const RateSetpoint &new_setpoint) {
+    setpoint = new_setpoint;
+}
+
+void RateLoop::arm(bool arm) {
+    if (arm == armed) return;
+    for (int i = 0; i < 3; i++) {
+        pid[i].reset();
+    }
+    armed = arm;
+}
+
+bool RateLoop::is_armed() const {
+    return armed;
+}
+
+void RateLoop::step(const float gyro[3], int64_t sample_us) {
+    // Use the measured sample spacing as dt, falling back to the nominal
+    // period on the first sample or after a long gap
+    float dt = period_us * 1e-6f;
+    if (primed) {
+        int64_t period = sample_us - last_sample_us;
+        if (period > 0) {
+            uint32_t p = (uint32_t)period;
+            if (p < stats.min_period_us) stats.min_period_us = p;
+            if (p > stats.max_period_us) stats.max_period_us = p;
+            if (p <= 4 * period_us) {
+                dt = p * 1e-6f;
+            }
+        }
+    }
+    account_until(sample_us);
+    last_sample_us = sample_us;
+    cycle_sample_us = sample_us;
+    primed = true;
+    lost_samples = 0;
+
+    if (!armed) {
+        actuator->disarm();
+        return;
+    }
+
+    float roll = pid[RATE_AXIS_ROLL].update(setpoint.roll, gyro[RATE_AXIS_ROLL], dt);
+    float pitch = pid[RATE_AXIS_PITCH].update(setpoint.pitch, gyro[RATE_AXIS_PITCH], dt);
+    float yaw = pid[RATE_AXIS_YAW].update(setpoint.yaw, gyro[RATE_AXIS_YAW], dt);
+
+    float motors[MOTOR_COUNT];
+    mixer_quad_x(setpoint.throttle, roll, pitch, yaw, motors);
+    actuator->write(motors);
+}
+
+void RateLoop::end_cycle(int64_t done_us) {
+    int64_t latency = done_us - cycle_sample_us;
+    uint32_t l = latency > 0 ? (uint32_t)latency : 0;
+
+    stats.cycles++;
+    stats.last_latency_us = l;
+    if (l > stats.max_latency_us) stats.max_latency_us = l;
+    if (l > budget_us) stats.overruns++;
+
+    service_snapshot();
+}
+
+void RateLoop::account_until(int64_t sample_us) {
+    // Anything beyond half a period late means samples were dropped. Samples
+    // already written off by note_missed_sample() are not counted again.
+    if (accounted_us >= 0) {
+        int64_t gap = sample_us - accounted_us;
+        if (gap > period_us + period_us / 2) {
+            uint32_t missed = (uint32_t)((gap + period_us / 2) / period_us) - 1;
+            stats.missed_samples += missed;
+        }
+    }
+    accounted_us = sample_us;
+}
+
+void RateLoop::note_missed_sample(int64_t now_us) {
+    // A sample is given up on half a period after it fell due
+    uint32_t missed = 1;
+    if (accounted_us >= 0) {
+        int64_t overdue = now_us - accounted_us - period_us / 2;
+        missed = overdue > 0 ? (uint32_t)(overdue / period_us) : 0;
+        accounted_us += (int64_t)missed * period_us;
+    }
+    stats.missed_samples += missed;
+    note_lost(missed);
+
+    service_snapshot();
+}
+
+void RateLoop::note_read_error(int64_t sample_us) {
+    account_until(sample_us);
+    stats.read_errors++;
+    note_lost(1);
+
+    service_snapshot();
+}
+
+void RateLoop::note_lost(uint32_t count) {
+    lost_samples += count;
+    if (!armed || lost_samples < RATE_LOOP_FAILSAFE_SAMPLES) return;
+
+    // Without fresh gyro data the last outputs would stay on the motors
+    arm(false);
+    actuator->disarm();
+    stats.failsafes++;
+}
+
+void RateLoop::service_snapshot() {
+    if (snapshot_state.load(std::memory_order_acquire) != SNAPSHOT_REQUESTED) return;
+
+    snapshot = stats;
+    reset_stats();
+    snapshot_state.store(SNAPSHOT_READY, std::memory_order_release);
+}
+
+void RateLoop::request_stats() {
+    int expected = SNAPSHOT_IDLE;
+    snapshot_state.compare_exchange_strong(expected, SNAPSHOT_REQUESTED, std::memory_order_acq_rel);
+}
+
+bool RateLoop::poll_stats(RateLoopStats &out) {
+    if (snapshot_state.load(std::memory_order_acquire) != SNAPSHOT_READY) return false;
+
+    out = snapshot;
+    snapshot_state.store(SNAPSHOT_IDLE, std::memory_order_release);
+    return true;
+}
+
+RateLoopStats RateLoop::get_stats() const {
+    return stats;
+}
+
+void RateLoop::reset_stats() {
+    stats = RateLoopStats{};
+    stats.min_period_us = UINT32_MAX;
+}
+
+void rate_loop_stats_merge(RateLoopStats &into, const RateLoopStats &from) {
+    into.cycles += from.cycles;
+    into.overruns += from.overruns;
+    into.missed_samples += from.missed_samples;
+    into.read_errors += from.read_errors;
+    into.failsafes += from.failsafes;
+    into.last_latency_us = from.last_latency_us;
+    if (from.max_latency_us > into.max_latency_us) into.max_latency_us = from.max_latency_us;
+    if (from.min_period_us < into.min_period_us) into.min_period_us = from.min_period_us;
+    if (from.max_period_us > into.max_period_us) into.max_period_us = from.max_period_us;
+}
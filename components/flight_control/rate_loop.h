@@ -0,0 +1,110 @@
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+
+#include "actuator.h"
+#include "pid.h"
+
+// Rate loop timing. The loop is clocked by IMU data-ready, so the period must
+// be a whole number of MPU6500 sample periods.
+#define RATE_LOOP_PERIOD_US     2000    // 500 Hz
+#define RATE_LOOP_BUDGET_US     1000    // Sample-to-actuator latency budget
+
+// Consecutive IMU samples that may be missed or fail to read before an armed
+// loop cuts the motors rather than leave the last outputs latched
+#define RATE_LOOP_FAILSAFE_SAMPLES  5   // 10 ms at 500 Hz
+
+// Default gains, in normalized torque per rad/s
+#define RATE_PID_ROLL_DEFAULT   { 0.08f, 0.15f, 0.0010f, 0.10f, 0.30f }
+#define RATE_PID_PITCH_DEFAULT  { 0.08f, 0.15f, 0.0010f, 0.10f, 0.30f }
+#define RATE_PID_YAW_DEFAULT    { 0.12f, 0.10f, 0.0f,    0.10f, 0.30f }
+
+enum RateAxis {
+    RATE_AXIS_ROLL  = 0,
+    RATE_AXIS_PITCH = 1,
+    RATE_AXIS_YAW   = 2,
+};
+
+struct RateSetpoint {
+    float roll;         // rad/s
+    float pitch;        // rad/s
+    float yaw;          // rad/s
+    float throttle;     // Collective, 0..1
+};
+
+struct RateLoopStats {
+    uint32_t cycles;
+    uint32_t overruns;          // Cycles whose latency exceeded the budget
+    uint32_t missed_samples;    // IMU samples skipped, inferred from sample spacing
+    uint32_t read_errors;       // IMU reads that failed after data-ready
+    uint32_t failsafes;         // Times the loop disarmed itself on lost samples
+    uint32_t last_latency_us;   // Sample arrival to actuator write
+    uint32_t max_latency_us;
+    uint32_t min_period_us;
+    uint32_t max_period_us;
+};
+
+// Inner rate controller: gyro in, motor commands out through an Actuator.
+// The loop never reads a clock itself; the caller supplies timestamps so the
+// same code is deterministic under the host simulator.
+class RateLoop {
+private:
+    Actuator *actuator;
+    Pid pid[3];
+    uint32_t period_us;
+    uint32_t budget_us;
+    RateSetpoint setpoint;
+    bool armed;
+    bool primed;
+    int64_t last_sample_us;
+    int64_t cycle_sample_us;
+    int64_t accounted_us;       // Samples due up to here are counted, -1 before the first
+    uint32_t lost_samples;      // Consecutive missed or unreadable samples
+    RateLoopStats stats;
+
+    // Cross-task stats handoff, see request_stats()
+    enum { SNAPSHOT_IDLE, SNAPSHOT_REQUESTED, SNAPSHOT_READY };
+    std::atomic<int> snapshot_state;
+    RateLoopStats snapshot;
+
+    void account_until(int64_t sample_us);
+    void note_lost(uint32_t count);
+    void service_snapshot();
+
+public:
+    RateLoop(Actuator *actuator,
+             uint32_t period_us = RATE_LOOP_PERIOD_US,
+             uint32_t budget_us = RATE_LOOP_BUDGET_US);
+
+    void set_gains(RateAxis axis, const PidGains &gains);
+    void set_setpoint(const RateSetpoint &setpoint);
+    void arm(bool armed);
+    bool is_armed() const;
+
+    // Runs one control cycle for a gyro sample (rad/s) captured at sample_us.
+    void step(const float gyro[3], int64_t sample_us);
+
+    // Closes the cycle opened by step(); done_us is when outputs were applied.
+    void end_cycle(int64_t done_us);
+
+    // Records a data-ready timeout at now_us. Every sample that fell due since
+    // the last one accounted for is counted as missed, not just one per timeout.
+    void note_missed_sample(int64_t now_us);
+
+    // Records a failed IMU read of the sample signalled at sample_us.
+    void note_read_error(int64_t sample_us);
+
+    // Only safe from the loop task, or while the loop is not running.
+    RateLoopStats get_stats() const;
+    void reset_stats();
+
+    // Safe from any task: asks the loop task to hand over its counters and
+    // start a new window at the end of its next cycle. poll_stats() returns
+    // true once, with the snapshot, after the loop has done so.
+    void request_stats();
+    bool poll_stats(RateLoopStats &out);
+};
+
+// Accumulates the counters of from into into.
+void rate_loop_stats_merge(RateLoopStats &into, const RateLoopStats &from);
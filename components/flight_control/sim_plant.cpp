@@ -0,0 +1,101 @@
+#include "sim_plant.h"
+
+// Integration step for the body dynamics
+#define SIM_PHYSICS_STEP_S 100e-6f
+
+SimPlant::SimPlant(const SimPlantParams &params) : params(params), command{}, thrust{}, rate{} {}
+
+void SimPlant::write(const float motors[MOTOR_COUNT]) {
+    for (int i = 0; i < MOTOR_COUNT; i++) {
+        command[i] = motors[i];
+    }
+}
+
+void SimPlant::disarm() {
+    for (int i = 0; i < MOTOR_COUNT; i++) {
+        command[i] = 0.0f;
+    }
+}
+
+void SimPlant::advance(float dt) {
+    while (dt > 0.0f) {
+        float h = dt < SIM_PHYSICS_STEP_S ? dt : SIM_PHYSICS_STEP_S;
+        dt -= h;
+
+        float torque[3] = { 0.0f, 0.0f, 0.0f };
+        for (int i = 0; i < MOTOR_COUNT; i++) {
+            thrust[i] += (command[i] - thrust[i]) * (h / (params.motor_tau + h));
+
+            // Thrust acts along -z at the motor position: r x F gives
+            // (-y * F, x * F), and a CCW prop reacts with a CW (+z) torque
+            float force = thrust[i] * params.max_thrust;
+            torque[0] -= params.motor_pos[i][1] * force;
+            torque[1] += params.motor_pos[i][0] * force;
+            torque[2] += params.motor_spin[i] * params.yaw_coeff * force;
+        }
+
+        for (int axis = 0; axis < 3; axis++) {
+            float net = torque[axis] - params.damping * rate[axis];
+            rate[axis] += net / params.inertia[axis] * h;
+        }
+    }
+}
+
+void SimPlant::apply_disturbance(const float torque[3], float dt) {
+    for (int axis = 0; axis < 3; axis++) {
+        rate[axis] += torque[axis] / params.inertia[axis] * dt;
+    }
+}
+
+void SimPlant::set_rates(const float rates[3]) {
+    for (int axis = 0; axis < 3; axis++) {
+        rate[axis] = rates[axis];
+    }
+}
+
+void SimPlant::read_gyro(float gyro[3]) const {
+    for (int axis = 0; axis < 3; axis++) {
+        gyro[axis] = rate[axis];
+    }
+}
+
+void SimPlant::read_command(float motors[MOTOR_COUNT]) const {
+    for (int i = 0; i < MOTOR_COUNT; i++) {
+        motors[i] = command[i];
+    }
+}
+
+void sim_run(RateLoop &loop, SimPlant &plant, const SimConfig &config,
+             sim_trace_cb_t trace, void *ctx) {
+    uint32_t latency_us = config.latency_us < config.sample_period_us
+                        ? config.latency_us : config.sample_period_us;
+    uint32_t sample = 0;
+    int64_t last_event_us = 0;
+
+    for (int64_t t = 0; t < config.duration_us; t += config.sample_period_us, sample++) {
+        float gyro[3];
+        plant.read_gyro(gyro);
+        if (trace) {
+            trace(t, gyro, ctx);
+        }
+
+        bool dropped = config.drop_every && sample % config.drop_every == config.drop_every - 1;
+        bool stopped = config.stop_us && t >= config.stop_us;
+        if (dropped || stopped) {
+            // The loop task only hears about it when its wait times out
+            if (config.timeout_us && t - last_event_us >= config.timeout_us) {
+                loop.note_missed_sample(t);
+                last_event_us = t;
+            }
+            plant.advance(config.sample_period_us * 1e-6f);
+            continue;
+        }
+        last_event_us = t;
+
+        // The plant keeps flying on the previous outputs while the loop computes
+        plant.advance(latency_us * 1e-6f);
+        loop.step(gyro, t);
+        loop.end_cycle(t + latency_us);
+        plant.advance((config.sample_period_us - latency_us) * 1e-6f);
+    }
+}
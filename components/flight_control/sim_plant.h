@@ -0,0 +1,76 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "actuator.h"
+#include "rate_loop.h"
+
+// Physical parameters of the simulated airframe. Motor geometry is given
+// independently of the mixer so a mixer sign or ordering error shows up as
+// a diverging simulation instead of cancelling out.
+struct SimPlantParams {
+    float inertia[3];                   // kg*m^2 about body x, y, z (FRD)
+    float motor_pos[MOTOR_COUNT][2];    // m, motor x (forward) and y (right)
+    float motor_spin[MOTOR_COUNT];      // +1 CCW, -1 CW, viewed from above
+    float max_thrust;                   // N per motor at full command
+    float yaw_coeff;                    // N*m of reaction torque per N of thrust
+    float motor_tau;                    // s, first-order motor spin-up time constant
+    float damping;                      // N*m per rad/s of rotational drag
+};
+
+// Roughly a 30 g ESP32 brushed quad with 92 mm diagonal motor spacing,
+// motors numbered as in mixer.h
+#define SIM_PLANT_DEFAULT_PARAMS {                                  \
+    { 1.4e-5f, 1.4e-5f, 2.2e-5f },                                  \
+    { { 0.0325f, 0.0325f }, { -0.0325f, 0.0325f },                  \
+      { -0.0325f, -0.0325f }, { 0.0325f, -0.0325f } },              \
+    { 1.0f, -1.0f, 1.0f, -1.0f },                                   \
+    0.15f, 0.006f, 0.02f, 2.0e-6f }
+
+// Rigid-body rotational model of the airframe, used in place of real motors
+// when tuning and regression-testing the rate loop on the host. Only body
+// rates are modelled; translation and gravity do not affect the inner loop.
+class SimPlant : public Actuator {
+private:
+    SimPlantParams params;
+    float command[MOTOR_COUNT];
+    float thrust[MOTOR_COUNT];  // Normalized, lags command by motor_tau
+    float rate[3];              // rad/s, body frame
+
+public:
+    SimPlant(const SimPlantParams &params = SimPlantParams SIM_PLANT_DEFAULT_PARAMS);
+
+    void write(const float motors[MOTOR_COUNT]) override;
+    void disarm() override;
+
+    // Integrates the body dynamics forward by dt seconds.
+    void advance(float dt);
+
+    // External torque (N*m) held for the next advance(), e.g. a gust or prop strike.
+    void apply_disturbance(const float torque[3], float dt);
+
+    void set_rates(const float rates[3]);
+    void read_gyro(float gyro[3]) const;
+
+    // Last motor command written, all zero after disarm().
+    void read_command(float motors[MOTOR_COUNT]) const;
+};
+
+struct SimConfig {
+    uint32_t duration_us;
+    uint32_t sample_period_us;  // IMU data-ready period
+    uint32_t latency_us;        // Sample arrival to actuator write
+    uint32_t drop_every;        // Drop every Nth IMU sample, 0 to never drop
+    uint32_t stop_us;           // No samples delivered from here on, 0 to never stop
+    uint32_t timeout_us;        // Data-ready timeout reported while samples are
+                                // not delivered, 0 to never report
+};
+
+// Called once per simulated sample with the plant rates before the loop runs
+typedef void (*sim_trace_cb_t)(int64_t t_us, const float rates[3], void *ctx);
+
+// Steps loop against plant on a fixed virtual clock. Every run with the same
+// inputs produces identical output, so traces and RateLoopStats can be
+// compared against a stored baseline.
+void sim_run(RateLoop &loop, SimPlant &plant, const SimConfig &config,
+             sim_trace_cb_t trace = nullptr, void *ctx = nullptr);
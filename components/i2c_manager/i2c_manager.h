@@ -10,7 +10,7 @@ extern "C" {
 // I2C configuration macros
 #define I2C_MASTER_SDA_IO          21
 #define I2C_MASTER_SCL_IO          22
-#define I2C_MASTER_FREQ_HZ         100000
+#define I2C_MASTER_FREQ_HZ         400000
 #define I2C_TIMEOUT_MS             1000
 
 /**
@@ -7,6 +7,9 @@
 
 static const char *TAG = "MPU6500";
 
+// ±8g: vibration peaks on a small quad easily exceed 2g
+static const float accel_scale = 8.0f / 32768.0f;
+
 // Constructor
 MPU6500::MPU6500(uint8_t address) : dev_addr(address), dev_handle(nullptr) {}
 
@@ -26,7 +29,7 @@ esp_err_t MPU6500::init(i2c_master_bus_handle_t bus_handle) {
     i2c_device_config_t dev_cfg = {
         .dev_addr_length = I2C_ADDR_BIT_LEN_7,
         .device_address = dev_addr,
-        .scl_speed_hz = 100000, // 100kHz
+        .scl_speed_hz = I2C_MASTER_FREQ_HZ, // A full read must fit well inside one 2ms sample
     };
 
     // Add device to the bus
@@ -54,22 +57,22 @@ esp_err_t MPU6500::init(i2c_master_bus_handle_t bus_handle) {
     if (err != ESP_OK) return err;
     
     // 2. Configure Digital Low-Pass Filter (DLPF)
-    err = write_register(CONFIG, 0x00);          // DLPF_CFG = 0 (Gyro: 250Hz BW)
+    err = write_register(CONFIG, 0x41);          // FIFO_MODE = 1 (stop when full), DLPF_CFG = 1 (Gyro: 184Hz BW, 1kHz internal rate)
     if (err != ESP_OK) return err;
 
     // 3. Configure sensors:
     err = write_register(GYRO_CONFIG, 0x00);     // Gyro: ±250°/s range
     if (err != ESP_OK) return err;
     
-    err = write_register(ACCEL_CONFIG, 0x00);    // Accel: ±2g range
+    err = write_register(ACCEL_CONFIG, 0x10);    // Accel: ±8g range
     if (err != ESP_OK) return err;
     
     // 4. Enable Accel DLPF (disable A_DLPF_CFG bypass)
-    err = write_register(ACCEL_CONFIG2, 0x01);   // Accel Fchoice_b = 0 (enable DLPF) 184Hz
+    err = write_register(ACCEL_CONFIG2, 0x00);   // Accel Fchoice_b = 0 (enable DLPF) 460Hz
     if (err != ESP_OK) return err;
 
     // 5. Sample Rate = 1kHz / (1 + SMPLRT_DIV)
-    err = write_register(SMPLRT_DIV, 0x04);      // Sample rate = 200Hz (1kHz/(1+4))
+    err = write_register(SMPLRT_DIV, 0x00);      // Sample rate = 1kHz
     if (err != ESP_OK) return err;
     
     ESP_LOGI(TAG, "MPU6500 initialized successfully");
@@ -122,16 +125,41 @@ esp_err_t MPU6500::read_whoami(uint8_t *who_am_i) {
     return read_register(WHO_AM_I, who_am_i, 1);
 }
 
-// Data reading
+// Route data-ready to the INT pin: active high, push-pull, 50us pulse.
+// The pulse clears itself so the ISR never has to touch the bus.
+esp_err_t MPU6500::enable_data_ready_interrupt() {
+    esp_err_t err = write_register(INT_PIN_CFG, 0x00);
+    if (err != ESP_OK) return err;
+
+    return write_register(INT_ENABLE, 0x01);     // RAW_RDY_EN
+}
+
+// Queue every accel sample in the FIFO, starting from empty
+esp_err_t MPU6500::enable_accel_fifo() {
+    esp_err_t err = write_register(FIFO_EN, 0x00);
+    if (err != ESP_OK) return err;
+
+    err = write_register(USER_CTRL, 0x04);       // FIFO_RST
+    if (err != ESP_OK) return err;
+
+    err = write_register(FIFO_EN, 0x08);         // ACCEL
+    if (err != ESP_OK) return err;
+
+    return write_register(USER_CTRL, 0x40);      // FIFO_EN
+}
+
+// Data reading. Called from the rate loop, so failures are returned
+// without logging and left to the caller to count.
 esp_err_t MPU6500::read_data(float* accel_x, float* accel_y, float* accel_z,
                              float* gyro_x, float* gyro_y, float* gyro_z) {
     if (dev_handle == nullptr) {
-        ESP_LOGE(TAG, "Device not initialized");
         return ESP_ERR_INVALID_STATE;
     }
 
+    uint8_t reg = 0x3B;
     uint8_t data[14];
-    esp_err_t err = read_register(0x3B, data, 14);
+    esp_err_t err = i2c_master_transmit_receive(dev_handle, &reg, 1, data, sizeof(data),
+                                                 MPU6500_READ_TIMEOUT_MS);
     if (err != ESP_OK) {
         return err;
     }
@@ -147,7 +175,6 @@ esp_err_t MPU6500::read_data(float* accel_x, float* accel_y, float* accel_z,
     int16_t gz = (data[12] << 8) | data[13];
     
     // Convert to physical values
-    const float accel_scale = 2.0f / 32768.0f;  // ±2g range
     const float gyro_scale = 250.0f / 32768.0f * (3.1415926535f / 180.0f);  // ±250dps to rad/s
     
     *accel_x = ax * accel_scale;
@@ -159,4 +186,52 @@ esp_err_t MPU6500::read_data(float* accel_x, float* accel_y, float* accel_z,
     *gyro_z = gz * gyro_scale;
     
     return ESP_OK;
-}
\ No newline at end of file
+}
+
+// FIFO draining. Called from the rate loop, so nothing here logs.
+esp_err_t MPU6500::read_accel_fifo(float accel[][3], size_t max_samples, size_t *count) {
+    *count = 0;
+    if (dev_handle == nullptr) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    uint8_t reg = FIFO_COUNTH;
+    uint8_t count_data[2];
+    esp_err_t err = i2c_master_transmit_receive(dev_handle, &reg, 1, count_data, sizeof(count_data),
+                                                MPU6500_READ_TIMEOUT_MS);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    // A full FIFO stops mid-sample and stays misaligned, so start over
+    size_t bytes = ((count_data[0] & 0x1F) << 8) | count_data[1];
+    if (bytes > MPU6500_FIFO_SIZE - MPU6500_FIFO_FRAME_LEN || bytes % MPU6500_FIFO_FRAME_LEN != 0) {
+        uint8_t reset[2] = {USER_CTRL, 0x44};    // FIFO_EN | FIFO_RST
+        err = i2c_master_transmit(dev_handle, reset, sizeof(reset), MPU6500_READ_TIMEOUT_MS);
+        return err != ESP_OK ? err : ESP_ERR_INVALID_SIZE;
+    }
+
+    size_t n = bytes / MPU6500_FIFO_FRAME_LEN;
+    if (n > max_samples) n = max_samples;
+    if (n == 0) {
+        return ESP_OK;
+    }
+
+    uint8_t data[MPU6500_FIFO_SIZE];
+    reg = FIFO_R_W;
+    err = i2c_master_transmit_receive(dev_handle, &reg, 1, data, n * MPU6500_FIFO_FRAME_LEN,
+                                      MPU6500_READ_TIMEOUT_MS);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        const uint8_t *frame = &data[i * MPU6500_FIFO_FRAME_LEN];
+        for (int axis = 0; axis < 3; axis++) {
+            int16_t raw = (frame[2 * axis] << 8) | frame[2 * axis + 1];
+            accel[i][axis] = raw * accel_scale;
+        }
+    }
+    *count = n;
+    return ESP_OK;
+}
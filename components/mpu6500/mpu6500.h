@@ -17,8 +17,29 @@ extern "C" {
 #define ACCEL_CONFIG    0x1C
 #define ACCEL_CONFIG2   0x1D
 #define SMPLRT_DIV      0x19
+#define FIFO_EN         0x23
+#define INT_PIN_CFG     0x37
+#define INT_ENABLE      0x38
+#define USER_CTRL       0x6A
+#define FIFO_COUNTH     0x72
+#define FIFO_R_W        0x74
 #define WHO_AM_I        0x75
 
+// Output data rate. Data-ready fires at this rate; gyro is filtered at 184 Hz,
+// accel at 460 Hz so the FIFO accel stream carries vibration up to Nyquist.
+#define MPU6500_SAMPLE_RATE_HZ  1000
+
+// Accel-only FIFO: 6 bytes per sample, 512 bytes deep (85 ms at 1 kHz)
+#define MPU6500_FIFO_SIZE       512
+#define MPU6500_FIFO_FRAME_LEN  6
+
+// Data-ready interrupt line, clocks the rate loop
+#define MPU6500_INT_IO  19
+
+// Sample read timeout in ms. A 14 byte burst takes about 0.4 ms at 400 kHz,
+// so anything longer is a stuck transfer the rate loop should give up on.
+#define MPU6500_READ_TIMEOUT_MS 2
+
 class MPU6500 {
 private:
     uint8_t dev_addr;
@@ -34,8 +55,15 @@ public:
     esp_err_t init(i2c_master_bus_handle_t bus_handle);
     esp_err_t deinit();
     esp_err_t read_whoami(uint8_t *who_am_i);
+    esp_err_t enable_data_ready_interrupt();
+    esp_err_t enable_accel_fifo();
     esp_err_t read_data(float* accel_x, float* accel_y, float* accel_z,
                         float* gyro_x, float* gyro_y, float* gyro_z);
+
+    // Drains up to max_samples accel samples (g, sensor frame) from the FIFO,
+    // oldest first. Returns ESP_ERR_INVALID_SIZE if the FIFO had overflowed;
+    // it is then reset and samples were lost. Does not log.
+    esp_err_t read_accel_fifo(float accel[][3], size_t max_samples, size_t *count);
 };
 
 #ifdef __cplusplus
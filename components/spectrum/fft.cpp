@@ -0,0 +1,82 @@
+#include "fft.h"
+
+#include <math.h>
+
+void fft_init_twiddle(float *twiddle, int n) {
+    for (int k = 0; k < n / 2; k++) {
+        float phase = -2.0f * (float)M_PI * k / n;
+        twiddle[2 * k] = cosf(phase);
+        twiddle[2 * k + 1] = sinf(phase);
+    }
+}
+
+// Complex FFT with twiddles taken every stride entries of a larger table
+static void fft_complex_strided(float *data, int n, const float *twiddle, int stride) {
+    // Bit-reversal permutation
+    for (int i = 1, j = 0; i < n; i++) {
+        int bit = n >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            float re = data[2 * i], im = data[2 * i + 1];
+            data[2 * i] = data[2 * j];
+            data[2 * i + 1] = data[2 * j + 1];
+            data[2 * j] = re;
+            data[2 * j + 1] = im;
+        }
+    }
+
+    // Butterflies
+    for (int len = 2; len <= n; len <<= 1) {
+        int half = len >> 1;
+        int step = (n / len) * stride;
+        for (int start = 0; start < n; start += len) {
+            for (int k = 0; k < half; k++) {
+                float wr = twiddle[2 * k * step];
+                float wi = twiddle[2 * k * step + 1];
+                float *a = &data[2 * (start + k)];
+                float *b = &data[2 * (start + k + half)];
+                float tr = b[0] * wr - b[1] * wi;
+                float ti = b[0] * wi + b[1] * wr;
+                b[0] = a[0] - tr;
+                b[1] = a[1] - ti;
+                a[0] += tr;
+                a[1] += ti;
+            }
+        }
+    }
+}
+
+void fft_complex(float *data, int n, const float *twiddle) {
+    fft_complex_strided(data, n, twiddle, 1);
+}
+
+void fft_real_magnitude(float *data, int n, const float *twiddle, float *magnitude) {
+    int m = n / 2;
+
+    // Treat even/odd samples as re/im of an n/2 point complex signal
+    fft_complex_strided(data, m, twiddle, 2);
+
+    // Split into the spectrum of the real signal:
+    // X[k] = (Z[k] + conj(Z[m-k])) / 2 - i/2 * (Z[k] - conj(Z[m-k])) * W^k
+    magnitude[0] = fabsf(data[0] + data[1]);
+    magnitude[m] = fabsf(data[0] - data[1]);
+    for (int k = 1; k < m; k++) {
+        float zr = data[2 * k], zi = data[2 * k + 1];
+        float cr = data[2 * (m - k)], ci = -data[2 * (m - k) + 1];
+
+        float er = 0.5f * (zr + cr), ei = 0.5f * (zi + ci);
+        float dr = 0.5f * (zr - cr), di = 0.5f * (zi - ci);
+
+        // -i * d * W^k
+        float wr = twiddle[2 * k], wi = twiddle[2 * k + 1];
+        float pr = dr * wr - di * wi;
+        float pi = dr * wi + di * wr;
+        float xr = er + pi;
+        float xi = ei - pr;
+
+        magnitude[k] = sqrtf(xr * xr + xi * xi);
+    }
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+// Radix-2 FFT kernels in the layout used by esp-dsp: complex data is
+// interleaved re/im floats and twiddles are precomputed once per size.
+
+// Fills twiddle with n/2 complex factors exp(-2*pi*i*k/n). n must be a power of two.
+void fft_init_twiddle(float *twiddle, int n);
+
+// In-place complex FFT of n points (2n floats) using a table from fft_init_twiddle(n).
+void fft_complex(float *data, int n, const float *twiddle);
+
+// Magnitudes of the first n/2 + 1 bins of the FFT of n real samples.
+// data holds the n samples and is overwritten; twiddle must come from
+// fft_init_twiddle(n), the half-size complex FFT uses every other factor.
+void fft_real_magnitude(float *data, int n, const float *twiddle, float *magnitude);
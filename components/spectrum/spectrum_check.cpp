@@ -0,0 +1,101 @@
+#include "spectrum_check.h"
+
+#include <math.h>
+#include <vector>
+
+#ifdef ESP_PLATFORM
+#include "esp_timer.h"
+#else
+#include <chrono>
+#endif
+
+static int64_t now_us() {
+#ifdef ESP_PLATFORM
+    return esp_timer_get_time();
+#else
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+void spectrum_reference(const float *samples, int n, double *amplitude) {
+    double mean = 0.0;
+    for (int i = 0; i < n; i++) {
+        mean += samples[i];
+    }
+    mean /= n;
+
+    // Windowed input and one period of cos/sin, indexed by (k * i) mod n
+    std::vector<double> x(n), cos_table(n), sin_table(n);
+    double window_gain = 0.0;
+    for (int i = 0; i < n; i++) {
+        cos_table[i] = cos(2.0 * M_PI * i / n);
+        sin_table[i] = sin(2.0 * M_PI * i / n);
+        double w = 0.5 - 0.5 * cos_table[i];
+        x[i] = (samples[i] - mean) * w;
+        window_gain += w;
+    }
+
+    for (int k = 0; k <= n / 2; k++) {
+        double re = 0.0, im = 0.0;
+        for (int i = 0, idx = 0; i < n; i++, idx = (idx + k) % n) {
+            re += x[i] * cos_table[idx];
+            im -= x[i] * sin_table[idx];
+        }
+        double scale = (k == 0 || k == n / 2) ? 1.0 : 2.0;
+        amplitude[k] = scale * sqrt(re * re + im * im) / window_gain;
+    }
+}
+
+// Deterministic vibration-like test signal: bias, prop tones and a small ramp
+static void test_signal(int axis, int i, uint16_t sample_rate_hz, float *value) {
+    float t = (float)i / sample_rate_hz;
+    float f1 = 0.19f * sample_rate_hz + 7.0f * axis;
+    float f2 = 0.31f * sample_rate_hz - 3.0f * axis;
+    *value = 0.02f * axis
+           + 0.05f * sinf(2.0f * (float)M_PI * f1 * t)
+           + 0.01f * sinf(2.0f * (float)M_PI * f2 * t + 0.3f)
+           + 1e-4f * i;
+}
+
+float spectrum_self_test(VibrationAnalyzer &analyzer, uint16_t sample_rate_hz) {
+    static float samples[3][SPECTRUM_FFT_SIZE];
+    static double reference[SPECTRUM_BINS];
+
+    analyzer.reset();
+    for (int i = 0; i < SPECTRUM_FFT_SIZE; i++) {
+        float sample[3];
+        for (int axis = 0; axis < 3; axis++) {
+            test_signal(axis, i, sample_rate_hz, &sample[axis]);
+            samples[axis][i] = sample[axis];
+        }
+        analyzer.push(sample);
+    }
+
+    float worst = 0.0f;
+    for (int axis = 0; axis < 3; axis++) {
+        spectrum_reference(samples[axis], SPECTRUM_FFT_SIZE, reference);
+        const float *amp = analyzer.amplitude(axis);
+
+        double peak = 0.0;
+        for (int k = 0; k < SPECTRUM_BINS; k++) {
+            if (reference[k] > peak) peak = reference[k];
+        }
+        for (int k = 0; k < SPECTRUM_BINS; k++) {
+            float err = (float)(fabs(amp[k] - reference[k]) / peak);
+            if (err > worst) worst = err;
+        }
+    }
+    analyzer.reset();
+    return worst;
+}
+
+float spectrum_benchmark(VibrationAnalyzer &analyzer, int iterations) {
+    static SpectrumSummary summary;
+
+    int64_t start = now_us();
+    for (int i = 0; i < iterations; i++) {
+        analyzer.analyze(summary);
+    }
+    return (float)(now_us() - start) / iterations;
+}
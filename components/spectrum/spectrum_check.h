@@ -0,0 +1,19 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "vibration_analyzer.h"
+
+// Reference single-sided amplitude spectrum by direct DFT in double precision,
+// using the same mean removal, Hann window and scaling as VibrationAnalyzer.
+// O(n^2) and soft-float double on the ESP32: meant for the host tests, or
+// on target only behind CONFIG_SPECTRUM_BOOT_SELF_TEST.
+void spectrum_reference(const float *samples, int n, double *amplitude);
+
+// Feeds a synthetic multi-tone signal through analyzer and compares each
+// axis against spectrum_reference(). Returns the largest bin error relative
+// to the strongest bin; single precision lands well below 1e-4.
+float spectrum_self_test(VibrationAnalyzer &analyzer, uint16_t sample_rate_hz);
+
+// Average time in microseconds for one analyze() of all three axes.
+float spectrum_benchmark(VibrationAnalyzer &analyzer, int iterations);
@@ -0,0 +1,148 @@
+#include "vibration_analyzer.h"
+#include "fft.h"
+
+#include <math.h>
+#include <string.h>
+
+VibrationAnalyzer::VibrationAnalyzer(uint16_t sample_rate_hz) : sample_rate_hz(sample_rate_hz) {
+    window_gain = 0.0f;
+    for (int i = 0; i < SPECTRUM_FFT_SIZE; i++) {
+        window[i] = 0.5f - 0.5f * cosf(2.0f * (float)M_PI * i / SPECTRUM_FFT_SIZE);
+        window_gain += window[i];
+    }
+    fft_init_twiddle(twiddle, SPECTRUM_FFT_SIZE);
+    reset();
+}
+
+void VibrationAnalyzer::reset() {
+    memset(history, 0, sizeof(history));
+    head = 0;
+    filled = 0;
+    since_window = 0;
+}
+
+bool VibrationAnalyzer::push(const float sample[3]) {
+    for (int axis = 0; axis < 3; axis++) {
+        history[axis][head] = sample[axis];
+    }
+    head = (head + 1) % SPECTRUM_FFT_SIZE;
+    if (filled < SPECTRUM_FFT_SIZE) filled++;
+
+    // Counted from the start too, so the first window is ready as soon as it fills
+    if (++since_window >= SPECTRUM_HOP && filled == SPECTRUM_FFT_SIZE) {
+        since_window = 0;
+        return true;
+    }
+    return false;
+}
+
+const float *VibrationAnalyzer::amplitude(int axis) {
+    // Unroll the ring oldest first and remove the mean (bias, or gravity on accel)
+    float mean = 0.0f;
+    for (int i = 0; i < SPECTRUM_FFT_SIZE; i++) {
+        mean += history[axis][i];
+    }
+    mean /= SPECTRUM_FFT_SIZE;
+
+    for (int i = 0; i < SPECTRUM_FFT_SIZE; i++) {
+        int idx = (head + i) % SPECTRUM_FFT_SIZE;
+        work[i] = (history[axis][idx] - mean) * window[i];
+    }
+
+    fft_real_magnitude(work, SPECTRUM_FFT_SIZE, twiddle, magnitude);
+
+    // Scale to single-sided amplitude, correcting for the window
+    float scale = 2.0f / window_gain;
+    for (int k = 0; k < SPECTRUM_BINS; k++) {
+        magnitude[k] *= scale;
+    }
+    magnitude[0] *= 0.5f;
+    magnitude[SPECTRUM_BINS - 1] *= 0.5f;
+    return magnitude;
+}
+
+uint8_t spectrum_quantize(float amplitude) {
+    float db = 20.0f * log10f(amplitude > 1e-9f ? amplitude : 1e-9f);
+    float level = (db - SPECTRUM_DB_FLOOR) / SPECTRUM_DB_STEP + 0.5f;
+    if (level < 0.0f) return 0;
+    if (level > 255.0f) return 255;
+    return (uint8_t)level;
+}
+
+void VibrationAnalyzer::analyze(SpectrumSummary &summary) {
+    const int bins_per_band = (SPECTRUM_BINS - 1) / SPECTRUM_BANDS;
+    const float bin_hz = (float)sample_rate_hz / SPECTRUM_FFT_SIZE;
+
+    summary.sample_rate_hz = sample_rate_hz;
+
+    for (int axis = 0; axis < 3; axis++) {
+        const float *amp = amplitude(axis);
+
+        // Peak-hold per band, skipping DC
+        for (int band = 0; band < SPECTRUM_BANDS; band++) {
+            float max_amp = 0.0f;
+            for (int k = band * bins_per_band + 1; k <= (band + 1) * bins_per_band; k++) {
+                if (k < SPECTRUM_BINS && amp[k] > max_amp) max_amp = amp[k];
+            }
+            summary.bands[axis][band] = spectrum_quantize(max_amp);
+        }
+
+        // Strongest local maxima, kept sorted by amplitude
+        int peak_bin[SPECTRUM_PEAKS];
+        float peak_amp[SPECTRUM_PEAKS];
+        for (int p = 0; p < SPECTRUM_PEAKS; p++) {
+            peak_bin[p] = 0;
+            peak_amp[p] = 0.0f;
+        }
+        for (int k = 2; k < SPECTRUM_BINS - 1; k++) {
+            if (amp[k] <= amp[k - 1] || amp[k] < amp[k + 1] || amp[k] <= peak_amp[SPECTRUM_PEAKS - 1]) {
+                continue;
+            }
+            int p = SPECTRUM_PEAKS - 1;
+            for (; p > 0 && amp[k] > peak_amp[p - 1]; p--) {
+                peak_amp[p] = peak_amp[p - 1];
+                peak_bin[p] = peak_bin[p - 1];
+            }
+            peak_amp[p] = amp[k];
+            peak_bin[p] = k;
+        }
+
+        for (int p = 0; p < SPECTRUM_PEAKS; p++) {
+            int k = peak_bin[p];
+            if (k == 0) {
+                summary.peaks[axis][p].freq_hz = 0.0f;
+                summary.peaks[axis][p].level = 0;
+                continue;
+            }
+
+            // Parabolic interpolation on log magnitude for sub-bin frequency
+            float a = logf(amp[k - 1] + 1e-12f);
+            float b = logf(amp[k] + 1e-12f);
+            float c = logf(amp[k + 1] + 1e-12f);
+            float denom = a - 2.0f * b + c;
+            float offset = denom != 0.0f ? 0.5f * (a - c) / denom : 0.0f;
+
+            summary.peaks[axis][p].freq_hz = (k + offset) * bin_hz;
+            summary.peaks[axis][p].level = spectrum_quantize(peak_amp[p]);
+        }
+    }
+}
+
+size_t spectrum_encode(const SpectrumSummary &summary, uint8_t *out) {
+    size_t n = 0;
+    out[n++] = summary.sample_rate_hz & 0xFF;
+    out[n++] = summary.sample_rate_hz >> 8;
+
+    for (int axis = 0; axis < 3; axis++) {
+        memcpy(&out[n], summary.bands[axis], SPECTRUM_BANDS);
+        n += SPECTRUM_BANDS;
+
+        for (int p = 0; p < SPECTRUM_PEAKS; p++) {
+            uint16_t freq = (uint16_t)(summary.peaks[axis][p].freq_hz * 10.0f + 0.5f);
+            out[n++] = freq & 0xFF;
+            out[n++] = freq >> 8;
+            out[n++] = summary.peaks[axis][p].level;
+        }
+    }
+    return n;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// At 1 kHz this gives 1.95 Hz bins and a 55 byte frame every 0.51 s, about
+// 107 B/s against 14 kB/s for raw accel frames at the full sample rate
+#define SPECTRUM_FFT_SIZE       512     // Samples per window, power of two
+#define SPECTRUM_HOP            512     // New samples between windows (no overlap)
+#define SPECTRUM_BANDS          8       // Linear bands per axis in the summary
+#define SPECTRUM_PEAKS          3       // Strongest peaks reported per axis
+#define SPECTRUM_DB_FLOOR       -100.0f // Quantized level 0
+#define SPECTRUM_DB_STEP        0.5f    // dB per quantized level
+
+#define SPECTRUM_BINS           (SPECTRUM_FFT_SIZE / 2 + 1)
+
+struct SpectrumPeak {
+    float freq_hz;      // Parabolic-interpolated peak frequency
+    uint8_t level;      // Quantized dB re 1 input unit (g on the drone), see SPECTRUM_DB_*
+};
+
+// Compact per-axis vibration summary of one window
+struct SpectrumSummary {
+    uint16_t sample_rate_hz;
+    uint8_t bands[3][SPECTRUM_BANDS];               // Quantized peak-hold level per band
+    SpectrumPeak peaks[3][SPECTRUM_PEAKS];          // Strongest first, level 0 when unused
+};
+
+// Bytes produced by spectrum_encode()
+#define SPECTRUM_ENCODED_LEN    (2 + 3 * (SPECTRUM_BANDS + SPECTRUM_PEAKS * 3))
+
+// Hann-windowed FFT analysis of a three-axis vibration stream, fed with FIFO
+// accel on the drone. push() is cheap and can be fed every sample; analyze()
+// does the FFTs and belongs in a low priority task.
+class VibrationAnalyzer {
+private:
+    uint16_t sample_rate_hz;
+    float history[3][SPECTRUM_FFT_SIZE];    // Ring buffer per axis
+    int head;
+    int filled;
+    int since_window;
+    float window[SPECTRUM_FFT_SIZE];
+    float window_gain;                      // Sum of window coefficients
+    float twiddle[SPECTRUM_FFT_SIZE];
+    float work[SPECTRUM_FFT_SIZE];
+    float magnitude[SPECTRUM_BINS];
+
+public:
+    VibrationAnalyzer(uint16_t sample_rate_hz);
+
+    void reset();
+
+    // Adds one sample. Returns true when a new window is ready.
+    bool push(const float sample[3]);
+
+    // Analyzes the latest SPECTRUM_FFT_SIZE samples.
+    void analyze(SpectrumSummary &summary);
+
+    // Single-sided amplitude spectrum (input units) of one axis of the latest window,
+    // SPECTRUM_BINS entries. Used to validate against the reference DFT.
+    const float *amplitude(int axis);
+};
+
+// Converts an amplitude in input units to a quantized level.
+uint8_t spectrum_quantize(float amplitude);
+
+// Serializes a summary little endian into SPECTRUM_ENCODED_LEN bytes:
+// sample rate, then per axis the bands followed by (freq_hz * 10 as u16, level) peaks.
+size_t spectrum_encode(const SpectrumSummary &summary, uint8_t *out);
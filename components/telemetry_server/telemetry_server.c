@@ -0,0 +1,477 @@
+#include "telemetry_server.h"
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include "esp_http_server.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "lwip/sockets.h"
+#include "mdns.h"
+
+static const char *TAG = "telemetry_server";
+
+static const char *stream_names[TELEM_STREAM_COUNT] = { "imu", "attitude", "stats", "spectrum" };
+
+typedef struct {
+    int fd;                                     // -1 when the slot is free
+    uint32_t period_us[TELEM_STREAM_COUNT];     // 0 when not subscribed
+    int64_t next_us[TELEM_STREAM_COUNT];
+} telem_client_t;
+
+typedef struct {
+    uint8_t data[TELEM_MAX_FRAME_LEN];
+    size_t len;
+    uint32_t seq;
+} telem_slot_t;
+
+// One frame queued to the httpd task for fan-out
+typedef struct {
+    atomic_bool busy;
+    telem_stream_t stream;
+    size_t len;
+    uint8_t data[TELEM_MAX_FRAME_LEN];
+} telem_work_t;
+
+// Frames in flight to the httpd task, two per stream
+#define TELEM_WORK_POOL (2 * TELEM_STREAM_COUNT)
+
+static httpd_handle_t server = NULL;
+
+// Client table, written only by the httpd task
+static telem_client_t clients[TELEM_MAX_CLIENTS];
+static SemaphoreHandle_t clients_lock = NULL;
+static StaticSemaphore_t clients_lock_buf;
+
+// Subscribed clients per stream, updated with the table under clients_lock
+// and read without it so publishers never wait on the httpd task
+static atomic_int subscribers[TELEM_STREAM_COUNT];
+
+// Latest frame per stream. Publishers only ever hold this spinlock for a copy.
+static telem_slot_t slots[TELEM_STREAM_COUNT];
+static portMUX_TYPE slots_mux = portMUX_INITIALIZER_UNLOCKED;
+
+static telem_work_t work_pool[TELEM_WORK_POOL];
+
+static TaskHandle_t sender_task_handle = NULL;
+static StaticTask_t sender_task_tcb;
+static StackType_t sender_task_stack[TELEM_TASK_STACK];
+
+static telem_work_t *work_alloc(void)
+{
+    for (int i = 0; i < TELEM_WORK_POOL; i++) {
+        bool expected = false;
+        if (atomic_compare_exchange_strong(&work_pool[i].busy, &expected, true)) {
+            return &work_pool[i];
+        }
+    }
+    return NULL;
+}
+
+static void work_free(telem_work_t *work)
+{
+    atomic_store(&work->busy, false);
+}
+
+static void clients_reset(void)
+{
+    memset(clients, 0, sizeof(clients));
+    for (int i = 0; i < TELEM_MAX_CLIENTS; i++) {
+        clients[i].fd = -1;
+    }
+    for (int s = 0; s < TELEM_STREAM_COUNT; s++) {
+        atomic_store(&subscribers[s], 0);
+    }
+}
+
+static esp_err_t client_add(int fd)
+{
+    int free_slot = -1;
+    xSemaphoreTake(clients_lock, portMAX_DELAY);
+    for (int i = 0; i < TELEM_MAX_CLIENTS; i++) {
+        if (clients[i].fd == fd) {
+            xSemaphoreGive(clients_lock);
+            return ESP_OK;
+        }
+        if (clients[i].fd < 0 && free_slot < 0) {
+            free_slot = i;
+        }
+    }
+    if (free_slot >= 0) {
+        memset(&clients[free_slot], 0, sizeof(clients[free_slot]));
+        clients[free_slot].fd = fd;
+    }
+    xSemaphoreGive(clients_lock);
+    return free_slot >= 0 ? ESP_OK : ESP_ERR_NO_MEM;
+}
+
+static void client_remove(int fd)
+{
+    xSemaphoreTake(clients_lock, portMAX_DELAY);
+    for (int i = 0; i < TELEM_MAX_CLIENTS; i++) {
+        if (clients[i].fd != fd) {
+            continue;
+        }
+        for (int s = 0; s < TELEM_STREAM_COUNT; s++) {
+            if (clients[i].period_us[s] != 0) {
+                atomic_fetch_sub(&subscribers[s], 1);
+            }
+        }
+        clients[i].fd = -1;
+    }
+    xSemaphoreGive(clients_lock);
+}
+
+static esp_err_t client_subscribe(int fd, telem_stream_t stream, uint32_t rate_hz)
+{
+    if (rate_hz > TELEM_MAX_RATE_HZ) {
+        rate_hz = TELEM_MAX_RATE_HZ;
+    }
+
+    esp_err_t err = ESP_ERR_NOT_FOUND;
+    xSemaphoreTake(clients_lock, portMAX_DELAY);
+    for (int i = 0; i < TELEM_MAX_CLIENTS; i++) {
+        if (clients[i].fd == fd) {
+            bool was_subscribed = clients[i].period_us[stream] != 0;
+            if (rate_hz && !was_subscribed) {
+                atomic_fetch_add(&subscribers[stream], 1);
+            } else if (!rate_hz && was_subscribed) {
+                atomic_fetch_sub(&subscribers[stream], 1);
+            }
+            clients[i].period_us[stream] = rate_hz ? 1000000 / rate_hz : 0;
+            clients[i].next_us[stream] = esp_timer_get_time();
+            err = ESP_OK;
+            break;
+        }
+    }
+    xSemaphoreGive(clients_lock);
+    return err;
+}
+
+static int stream_from_name(const char *name)
+{
+    for (int i = 0; i < TELEM_STREAM_COUNT; i++) {
+        if (strcmp(name, stream_names[i]) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Handles "sub <stream> <rate_hz>" and "unsub <stream>"
+static esp_err_t handle_command(int fd, const char *cmd)
+{
+    char name[16];
+    unsigned long rate_hz = 0;
+
+    if (sscanf(cmd, "sub %15s %lu", name, &rate_hz) == 2 && rate_hz > 0) {
+        int stream = stream_from_name(name);
+        if (stream < 0) return ESP_ERR_INVALID_ARG;
+        ESP_LOGI(TAG, "Client %d subscribed to %s at %lu Hz", fd, name, rate_hz);
+        return client_subscribe(fd, (telem_stream_t)stream, rate_hz);
+    }
+    if (sscanf(cmd, "unsub %15s", name) == 1) {
+        int stream = stream_from_name(name);
+        if (stream < 0) return ESP_ERR_INVALID_ARG;
+        ESP_LOGI(TAG, "Client %d unsubscribed from %s", fd, name);
+        return client_subscribe(fd, (telem_stream_t)stream, 0);
+    }
+    return ESP_ERR_INVALID_ARG;
+}
+
+static esp_err_t ws_handler(httpd_req_t *req)
+{
+    int fd = httpd_req_to_sockfd(req);
+
+    // Handshake
+    if (req->method == HTTP_GET) {
+        esp_err_t err = client_add(fd);
+        if (err != ESP_OK) {
+            ESP_LOGW(TAG, "Rejecting client %d, %d already connected", fd, TELEM_MAX_CLIENTS);
+            return err;
+        }
+        ESP_LOGI(TAG, "Client %d connected", fd);
+        return ESP_OK;
+    }
+
+    uint8_t buf[64];
+    httpd_ws_frame_t frame;
+    memset(&frame, 0, sizeof(frame));
+    esp_err_t err = httpd_ws_recv_frame(req, &frame, 0);
+    if (err != ESP_OK) {
+        return err;
+    }
+    // The payload has to be consumed or the session desyncs; frames too big
+    // to read in one go are not part of the protocol, so drop the client
+    if (frame.len >= sizeof(buf)) {
+        ESP_LOGW(TAG, "Client %d sent a %u byte frame, closing", fd, (unsigned)frame.len);
+        return ESP_FAIL;
+    }
+
+    frame.payload = buf;
+    err = httpd_ws_recv_frame(req, &frame, sizeof(buf) - 1);
+    if (err != ESP_OK) {
+        return err;
+    }
+    if (frame.type != HTTPD_WS_TYPE_TEXT) {
+        return ESP_OK;
+    }
+    buf[frame.len] = '\0';
+
+    const char *reply = handle_command(fd, (const char *)buf) == ESP_OK ? "ok" : "error";
+    httpd_ws_frame_t resp = {
+        .type = HTTPD_WS_TYPE_TEXT,
+        .payload = (uint8_t *)reply,
+        .len = strlen(reply),
+    };
+    return httpd_ws_send_frame(req, &resp);
+}
+
+// Called by httpd for every accepted socket, after it has applied its own
+// timeouts. send_wait_timeout only takes whole seconds, far too long for the
+// single httpd task to sit on one slow client while the others wait.
+static esp_err_t on_open(httpd_handle_t hd, int fd)
+{
+    struct timeval timeout = {
+        .tv_sec = 0,
+        .tv_usec = TELEM_SEND_TIMEOUT_MS * 1000,
+    };
+    if (setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout)) != 0) {
+        ESP_LOGW(TAG, "Could not set send timeout on socket %d", fd);
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+// Called by httpd for every closed session
+static void on_close(httpd_handle_t hd, int fd)
+{
+    client_remove(fd);
+    ESP_LOGI(TAG, "Client %d disconnected", fd);
+    close(fd);
+}
+
+// Fans a frame out to the subscribers that are due. Runs on the httpd task,
+// the only task that writes to client sockets, so frames never interleave
+// with handler replies and an fd cannot be closed and reused mid-send.
+// A slow client can block it for up to TELEM_SEND_TIMEOUT_MS, then is dropped.
+static void send_work(void *arg)
+{
+    telem_work_t *work = (telem_work_t *)arg;
+    int fds[TELEM_MAX_CLIENTS];
+    int n = 0;
+    int64_t now = esp_timer_get_time();
+
+    xSemaphoreTake(clients_lock, portMAX_DELAY);
+    for (int i = 0; i < TELEM_MAX_CLIENTS; i++) {
+        telem_client_t *c = &clients[i];
+        if (c->fd < 0 || c->period_us[work->stream] == 0 || now < c->next_us[work->stream]) {
+            continue;
+        }
+        c->next_us[work->stream] += c->period_us[work->stream];
+        if (c->next_us[work->stream] <= now) {
+            c->next_us[work->stream] = now + c->period_us[work->stream];
+        }
+        fds[n++] = c->fd;
+    }
+    xSemaphoreGive(clients_lock);
+
+    httpd_ws_frame_t pkt = {
+        .type = HTTPD_WS_TYPE_BINARY,
+        .payload = work->data,
+        .len = work->len,
+    };
+    for (int i = 0; i < n; i++) {
+        if (httpd_ws_get_fd_info(server, fds[i]) != HTTPD_WS_CLIENT_WEBSOCKET) {
+            continue;
+        }
+        if (httpd_ws_send_frame_async(server, fds[i], &pkt) != ESP_OK) {
+            ESP_LOGW(TAG, "Send to client %d failed, closing", fds[i]);
+            httpd_sess_trigger_close(server, fds[i]);
+        }
+    }
+
+    work_free(work);
+}
+
+// Moves each newly published frame into a work item for the httpd task.
+// Keeps publishers decoupled from httpd_queue_work and its control socket.
+static void telemetry_sender_task(void *arg)
+{
+    uint32_t sent_seq[TELEM_STREAM_COUNT] = {0};
+
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        for (int s = 0; s < TELEM_STREAM_COUNT; s++) {
+            if (slots[s].seq == sent_seq[s] || server == NULL) {
+                continue;
+            }
+            // Nobody to send to: not worth a round trip through the httpd task
+            if (atomic_load(&subscribers[s]) == 0) {
+                sent_seq[s] = slots[s].seq;
+                continue;
+            }
+
+            // Frames still queued from earlier are not worth waiting for
+            telem_work_t *work = work_alloc();
+            if (work == NULL) {
+                continue;
+            }
+
+            taskENTER_CRITICAL(&slots_mux);
+            sent_seq[s] = slots[s].seq;
+            work->len = slots[s].len;
+            memcpy(work->data, slots[s].data, work->len);
+            taskEXIT_CRITICAL(&slots_mux);
+
+            work->stream = (telem_stream_t)s;
+            if (httpd_queue_work(server, send_work, work) != ESP_OK) {
+                work_free(work);
+            }
+        }
+    }
+}
+
+static void mdns_advertise(void)
+{
+    esp_err_t err = mdns_init();
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "mDNS init failed: %s", esp_err_to_name(err));
+        return;
+    }
+
+    mdns_hostname_set(TELEM_HOSTNAME);
+    mdns_instance_name_set("ESP drone telemetry");
+
+    mdns_txt_item_t txt[] = {
+        { "path", TELEM_WS_URI },
+        { "streams", "imu,attitude,stats,spectrum" },
+    };
+    err = mdns_service_add(NULL, "_http", "_tcp", TELEM_PORT, txt, sizeof(txt) / sizeof(txt[0]));
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "mDNS service add failed: %s", esp_err_to_name(err));
+        return;
+    }
+    ESP_LOGI(TAG, "Advertising ws://%s.local%s", TELEM_HOSTNAME, TELEM_WS_URI);
+}
+
+esp_err_t telemetry_server_start(void)
+{
+    if (server != NULL) {
+        return ESP_OK;
+    }
+
+    if (clients_lock == NULL) {
+        clients_lock = xSemaphoreCreateMutexStatic(&clients_lock_buf);
+    }
+    clients_reset();
+    for (int i = 0; i < TELEM_WORK_POOL; i++) {
+        work_free(&work_pool[i]);
+    }
+
+    httpd_config_t config = HTTPD_DEFAULT_CONFIG();
+    config.server_port = TELEM_PORT;
+    config.core_id = TELEM_TASK_CORE;
+    // One spare socket so an extra connection reaches ws_handler and is
+    // rejected there; never purge a connected subscriber to make room
+    config.max_open_sockets = TELEM_MAX_CLIENTS + 1;
+    config.lru_purge_enable = false;
+    config.open_fn = on_open;
+    config.close_fn = on_close;
+
+    esp_err_t err = httpd_start(&server, &config);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "HTTP server start failed: %s", esp_err_to_name(err));
+        server = NULL;
+        return err;
+    }
+
+    httpd_uri_t ws_uri = {
+        .uri = TELEM_WS_URI,
+        .method = HTTP_GET,
+        .handler = ws_handler,
+        .user_ctx = NULL,
+        .is_websocket = true,
+    };
+    err = httpd_register_uri_handler(server, &ws_uri);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "WebSocket handler registration failed: %s", esp_err_to_name(err));
+        telemetry_server_stop();
+        return err;
+    }
+
+    if (sender_task_handle == NULL) {
+        sender_task_handle = xTaskCreateStaticPinnedToCore(
+            telemetry_sender_task,  "telem_sender",
+            TELEM_TASK_STACK,       NULL,
+            TELEM_TASK_PRIORITY,    sender_task_stack,
+            &sender_task_tcb,       TELEM_TASK_CORE
+        );
+    }
+
+    mdns_advertise();
+
+    ESP_LOGI(TAG, "Telemetry server listening on port %d", TELEM_PORT);
+    return ESP_OK;
+}
+
+void telemetry_server_publish(telem_stream_t stream, const uint8_t *frame, size_t len)
+{
+    if (stream >= TELEM_STREAM_COUNT || len > TELEM_MAX_FRAME_LEN) {
+        return;
+    }
+
+    taskENTER_CRITICAL(&slots_mux);
+    memcpy(slots[stream].data, frame, len);
+    slots[stream].len = len;
+    slots[stream].seq++;
+    taskEXIT_CRITICAL(&slots_mux);
+
+    if (sender_task_handle != NULL) {
+        xTaskNotifyGive(sender_task_handle);
+    }
+}
+
+bool telemetry_server_has_subscribers(telem_stream_t stream)
+{
+    if (stream >= TELEM_STREAM_COUNT) {
+        return false;
+    }
+    return atomic_load(&subscribers[stream]) > 0;
+}
+
+int telemetry_server_client_count(void)
+{
+    if (clients_lock == NULL) {
+        return 0;
+    }
+
+    int count = 0;
+    xSemaphoreTake(clients_lock, portMAX_DELAY);
+    for (int i = 0; i < TELEM_MAX_CLIENTS; i++) {
+        if (clients[i].fd >= 0) {
+            count++;
+        }
+    }
+    xSemaphoreGive(clients_lock);
+    return count;
+}
+
+TaskHandle_t telemetry_server_task_handle(void)
+{
+    return sender_task_handle;
+}
+
+void telemetry_server_stop(void)
+{
+    if (server) {
+        httpd_stop(server);
+        server = NULL;
+    }
+    mdns_free();
+}
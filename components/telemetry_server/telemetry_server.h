@@ -0,0 +1,92 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Server configuration macros
+#define TELEM_HOSTNAME          "esp-drone"     // Advertised as esp-drone.local
+#define TELEM_PORT              80
+#define TELEM_WS_URI            "/ws"
+#define TELEM_MAX_CLIENTS       4               // Further connections are refused
+#define TELEM_MAX_FRAME_LEN     96
+#define TELEM_MAX_RATE_HZ       200
+#define TELEM_SEND_TIMEOUT_MS   20              // Per client, before it is dropped
+#define TELEM_TASK_CORE         0               // Protocol core, next to lwIP
+#define TELEM_TASK_PRIORITY     4
+#define TELEM_TASK_STACK        4096
+
+/**
+ * @brief Streams a client can subscribe to.
+ *
+ * Clients send text frames "sub <stream> <rate_hz>" and "unsub <stream>",
+ * where <stream> is one of the names below. Data is sent as binary frames.
+ */
+typedef enum {
+    TELEM_STREAM_IMU = 0,       // "imu"
+    TELEM_STREAM_ATTITUDE,      // "attitude"
+    TELEM_STREAM_STATS,         // "stats"
+    TELEM_STREAM_SPECTRUM,      // "spectrum"
+    TELEM_STREAM_COUNT,
+} telem_stream_t;
+
+/**
+ * @brief Start the WebSocket server, the sender task and mDNS advertisement.
+ *
+ * @return ESP_OK on success, error code otherwise.
+ */
+esp_err_t telemetry_server_start(void);
+
+/**
+ * @brief Publish the latest encoded frame of a stream.
+ *
+ * The frame is copied once and fanned out to subscribers on the httpd task.
+ * Never blocks, so it is safe to call from acquisition tasks; a frame that is
+ * not sent before the next publish of the same stream is replaced.
+ *
+ * @param stream Stream the frame belongs to
+ * @param frame  Encoded frame
+ * @param len    Frame length in bytes, at most TELEM_MAX_FRAME_LEN
+ */
+void telemetry_server_publish(telem_stream_t stream, const uint8_t *frame, size_t len);
+
+/**
+ * @brief Check whether any client is subscribed to a stream.
+ *
+ * Never blocks. Publishers use it to skip encoding frames nobody will
+ * receive; publishing anyway is harmless but wasted work.
+ *
+ * @param stream Stream to check
+ * @return true if at least one connected client is subscribed
+ */
+bool telemetry_server_has_subscribers(telem_stream_t stream);
+
+/**
+ * @brief Get the number of connected WebSocket clients.
+ */
+int telemetry_server_client_count(void);
+
+/**
+ * @brief Get the handle of the statically allocated sender task.
+ *
+ * Its stack is TELEM_TASK_STACK bytes.
+ *
+ * @return Task handle, or NULL before telemetry_server_start().
+ */
+TaskHandle_t telemetry_server_task_handle(void);
+
+/**
+ * @brief Stop the server and drop all clients.
+ */
+void telemetry_server_stop(void);
+
+#ifdef __cplusplus
+}
+#endif
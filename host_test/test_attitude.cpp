@@ -0,0 +1,71 @@
+#include <math.h>
+
+#include "test_check.h"
+#include "attitude.h"
+
+// Specific force (g) in FRD body axes for a craft at rest at roll phi, pitch theta
+static void gravity_body(float phi, float theta, float accel[3]) {
+    accel[0] = sinf(theta);
+    accel[1] = -sinf(phi) * cosf(theta);
+    accel[2] = -cosf(phi) * cosf(theta);
+}
+
+static void test_level() {
+    AttitudeEstimator estimator;
+    const float accel[3] = { 0.0f, 0.0f, -1.0f };
+    const float gyro[3] = { 0.0f, 0.0f, 0.0f };
+    estimator.update(accel, gyro, 0.002f);
+    estimator.update(accel, gyro, 0.002f);
+
+    float attitude[3];
+    estimator.get(attitude);
+    CHECK_NEAR(attitude[0], 0.0, 1e-6);
+    CHECK_NEAR(attitude[1], 0.0, 1e-6);
+}
+
+static void test_static_tilt() {
+    AttitudeEstimator estimator;
+    float accel[3];
+    gravity_body(0.3f, -0.2f, accel);
+    const float gyro[3] = { 0.0f, 0.0f, 0.0f };
+    for (int i = 0; i < 100; i++) {
+        estimator.update(accel, gyro, 0.002f);
+    }
+
+    float attitude[3];
+    estimator.get(attitude);
+    CHECK_NEAR(attitude[0], 0.3, 1e-4);
+    CHECK_NEAR(attitude[1], -0.2, 1e-4);
+}
+
+// Rolling right at a constant rate: gyro integration and the accel gravity
+// vector must agree, so the estimate follows the true angle without lag
+// building up between the two paths
+static void test_roll_gyro_and_accel_agree() {
+    AttitudeEstimator estimator;
+    const float rate = 0.5f;
+    const float dt = 0.002f;
+    float accel[3];
+    const float gyro[3] = { rate, 0.0f, 0.0f };
+
+    float phi = 0.0f;
+    for (int i = 0; i < 600; i++) {
+        gravity_body(phi, 0.0f, accel);
+        estimator.update(accel, gyro, dt);
+        phi += rate * dt;
+    }
+
+    float attitude[3];
+    estimator.get(attitude);
+    CHECK_NEAR(attitude[0], phi - rate * dt, 0.01);
+    CHECK(attitude[0] > 0.5f);
+}
+
+int main() {
+    test_level();
+    test_static_tilt();
+    test_roll_gyro_and_accel_agree();
+
+    printf("test_attitude: %s\n", check_failures ? "FAILED" : "OK");
+    return check_failures;
+}
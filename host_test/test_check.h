@@ -0,0 +1,24 @@
+#pragma once
+
+#include <stdio.h>
+
+// Minimal assertion helpers; each test binary returns the failure count
+static int check_failures = 0;
+
+#define CHECK(cond)                                                         \
+    do {                                                                    \
+        if (!(cond)) {                                                      \
+            printf("%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+            check_failures++;                                               \
+        }                                                                   \
+    } while (0)
+
+#define CHECK_NEAR(a, b, tol)                                               \
+    do {                                                                    \
+        double _a = (a), _b = (b);                                          \
+        if (!(_a - _b <= (tol) && _b - _a <= (tol))) {                      \
+            printf("%s:%d: CHECK_NEAR failed: %s = %g, %s = %g, tol %g\n",  \
+                   __FILE__, __LINE__, #a, _a, #b, _b, (double)(tol));      \
+            check_failures++;                                               \
+        }                                                                   \
+    } while (0)
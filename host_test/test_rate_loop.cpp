@@ -0,0 +1,202 @@
+#include <math.h>
+#include <string.h>
+
+#include "test_check.h"
+#include "sim_plant.h"
+
+// Rates must track a step within 5% after this long
+#define SETTLE_US 300000
+
+static void test_step_response() {
+    SimPlant plant;
+    RateLoop loop(&plant);
+    loop.arm(true);
+    loop.set_setpoint({ 1.0f, -0.5f, 0.5f, 0.5f });
+
+    SimConfig config = { SETTLE_US, RATE_LOOP_PERIOD_US, 400, 0 };
+    sim_run(loop, plant, config);
+
+    float gyro[3];
+    plant.read_gyro(gyro);
+    CHECK_NEAR(gyro[RATE_AXIS_ROLL], 1.0, 0.05);
+    CHECK_NEAR(gyro[RATE_AXIS_PITCH], -0.5, 0.025);
+    CHECK_NEAR(gyro[RATE_AXIS_YAW], 0.5, 0.025);
+
+    RateLoopStats stats = loop.get_stats();
+    CHECK(stats.cycles == SETTLE_US / RATE_LOOP_PERIOD_US);
+    CHECK(stats.overruns == 0);
+    CHECK(stats.missed_samples == 0);
+    CHECK(stats.max_latency_us == 400);
+    CHECK(stats.min_period_us == RATE_LOOP_PERIOD_US);
+    CHECK(stats.max_period_us == RATE_LOOP_PERIOD_US);
+}
+
+// A knock on every axis must be damped back to level within a second
+static void test_disturbance_rejection() {
+    SimPlant plant;
+    RateLoop loop(&plant);
+    loop.arm(true);
+    loop.set_setpoint({ 0.0f, 0.0f, 0.0f, 0.5f });
+
+    const float knock[3] = { 3.0f, -3.0f, 2.0f };
+    plant.set_rates(knock);
+
+    SimConfig config = { 1000000, RATE_LOOP_PERIOD_US, 400, 0 };
+    sim_run(loop, plant, config);
+
+    float gyro[3];
+    plant.read_gyro(gyro);
+    for (int axis = 0; axis < 3; axis++) {
+        CHECK_NEAR(gyro[axis], 0.0, 0.05);
+    }
+}
+
+static void test_overrun_accounting() {
+    SimPlant plant;
+    RateLoop loop(&plant);
+    loop.arm(true);
+
+    SimConfig config = { 100000, RATE_LOOP_PERIOD_US, RATE_LOOP_BUDGET_US + 500, 0 };
+    sim_run(loop, plant, config);
+
+    RateLoopStats stats = loop.get_stats();
+    CHECK(stats.cycles == 50);
+    CHECK(stats.overruns == 50);
+    CHECK(stats.max_latency_us == RATE_LOOP_BUDGET_US + 500);
+}
+
+static void test_missed_samples() {
+    SimPlant plant;
+    RateLoop loop(&plant);
+    loop.arm(true);
+
+    // Samples 9, 19, ... 49 dropped; the last drop has no following sample
+    SimConfig config = { 100000, RATE_LOOP_PERIOD_US, 400, 10 };
+    sim_run(loop, plant, config);
+
+    RateLoopStats stats = loop.get_stats();
+    CHECK(stats.cycles == 45);
+    CHECK(stats.missed_samples == 4);
+    CHECK(stats.max_period_us == 2 * RATE_LOOP_PERIOD_US);
+    CHECK(stats.overruns == 0);
+}
+
+// Losing the IMU while armed must cut the motors within the failsafe window,
+// not leave the last outputs latched
+static void test_failsafe_on_lost_samples() {
+    SimPlant plant;
+    RateLoop loop(&plant);
+    loop.arm(true);
+    loop.set_setpoint({ 0.0f, 0.0f, 0.0f, 0.5f });
+
+    // Samples stop at 100 ms, the loop task times out every 5 ms after that
+    SimConfig config = { 150000, RATE_LOOP_PERIOD_US, 400, 0, 100000, 5000 };
+    sim_run(loop, plant, config);
+
+    float motors[MOTOR_COUNT];
+    plant.read_command(motors);
+    for (int i = 0; i < MOTOR_COUNT; i++) {
+        CHECK(motors[i] == 0.0f);
+    }
+    CHECK(!loop.is_armed());
+
+    // Every period without a sample is counted, not one per timeout
+    RateLoopStats stats = loop.get_stats();
+    CHECK(stats.cycles == 50);
+    CHECK(stats.failsafes == 1);
+    CHECK(stats.missed_samples >= 20);
+    CHECK(stats.missed_samples <= 25);
+}
+
+// A few late samples must not trip the failsafe
+static void test_failsafe_tolerates_short_gaps() {
+    SimPlant plant;
+    RateLoop loop(&plant);
+    loop.arm(true);
+
+    SimConfig config = { 100000, RATE_LOOP_PERIOD_US, 400, 3, 0, 5000 };
+    sim_run(loop, plant, config);
+
+    RateLoopStats stats = loop.get_stats();
+    CHECK(loop.is_armed());
+    CHECK(stats.failsafes == 0);
+    CHECK(stats.missed_samples == 16);
+}
+
+static void test_disarmed_outputs_nothing() {
+    SimPlant plant;
+    RateLoop loop(&plant);
+    loop.set_setpoint({ 1.0f, 1.0f, 1.0f, 0.5f });
+
+    SimConfig config = { 100000, RATE_LOOP_PERIOD_US, 400, 0 };
+    sim_run(loop, plant, config);
+
+    float gyro[3];
+    plant.read_gyro(gyro);
+    for (int axis = 0; axis < 3; axis++) {
+        CHECK(gyro[axis] == 0.0f);
+    }
+}
+
+static void test_stats_handoff() {
+    SimPlant plant;
+    RateLoop loop(&plant);
+    loop.arm(true);
+
+    RateLoopStats stats;
+    CHECK(!loop.poll_stats(stats));
+
+    loop.request_stats();
+    SimConfig config = { 10000, RATE_LOOP_PERIOD_US, 400, 0 };
+    sim_run(loop, plant, config);
+
+    // The first cycle after the request hands over and starts a new window
+    CHECK(loop.poll_stats(stats));
+    CHECK(stats.cycles == 1);
+    CHECK(loop.get_stats().cycles == 4);
+    CHECK(!loop.poll_stats(stats));
+}
+
+struct Trace {
+    float rates[64][3];
+    int count;
+};
+
+static void record_trace(int64_t t_us, const float rates[3], void *ctx) {
+    Trace *trace = static_cast<Trace *>(ctx);
+    if (trace->count < 64) {
+        memcpy(trace->rates[trace->count++], rates, sizeof(trace->rates[0]));
+    }
+}
+
+// Same inputs must give bit-identical traces so runs can be diffed
+static void test_deterministic() {
+    static Trace traces[2];
+    for (int run = 0; run < 2; run++) {
+        SimPlant plant;
+        RateLoop loop(&plant);
+        loop.arm(true);
+        loop.set_setpoint({ 2.0f, -1.0f, 1.0f, 0.4f });
+
+        SimConfig config = { 64 * RATE_LOOP_PERIOD_US, RATE_LOOP_PERIOD_US, 700, 7 };
+        traces[run].count = 0;
+        sim_run(loop, plant, config, record_trace, &traces[run]);
+    }
+    CHECK(traces[0].count == 64);
+    CHECK(memcmp(traces[0].rates, traces[1].rates, sizeof(traces[0].rates)) == 0);
+}
+
+int main() {
+    test_step_response();
+    test_disturbance_rejection();
+    test_overrun_accounting();
+    test_missed_samples();
+    test_failsafe_on_lost_samples();
+    test_failsafe_tolerates_short_gaps();
+    test_disarmed_outputs_nothing();
+    test_stats_handoff();
+    test_deterministic();
+
+    printf("test_rate_loop: %s\n", check_failures ? "FAILED" : "OK");
+    return check_failures;
+}
@@ -1,63 +1,382 @@
 #include <stdio.h>
 #include <string.h>
 #include <algorithm>
+#include <atomic>
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/queue.h"
 
 #include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
 
 #include "driver/gpio.h"
 #include "nvs_flash.h"
 
 #include "WifiManager.h"
-#include "web_socket_client.h"
+#include "telemetry_server.h"
 #include "i2c_manager.h"
 #include "MPU6500.h"
+#include "attitude.h"
+#include "ledc_actuator.h"
+#include "rate_loop.h"
+#include "vibration_analyzer.h"
+#include "spectrum_check.h"
+
+// Wait this long for data-ready before reporting missed IMU samples
+#define IMU_TIMEOUT_MS          5
+#define LOOP_STATS_INTERVAL_MS  5000
+
+// Telemetry encoding rates; subscribers pick their own rate up to these
+#define TELEMETRY_PERIOD_MS     5       // 200Hz IMU and attitude
+#define TELEMETRY_STATS_DIV     20      // 10Hz stats
+
+// Telemetry frame: sync byte, flags byte naming the payload, little endian payload
+#define FRAME_SYNC              0xAA
+#define FRAME_FLAG_GYRO         0x01
+#define FRAME_FLAG_ACCEL        0x02
+#define FRAME_FLAG_ATTITUDE     0x04
+#define FRAME_FLAG_STATS        0x08
+#define FRAME_FLAG_SPECTRUM     0x10
+
+// Core layout: WiFi and lwIP stay on the protocol core (see sdkconfig), so
+// sensing and control get the app core to themselves
+#define PROTOCOL_CORE           0
+#define APP_CORE                1
+
+// Task stacks in bytes; check the boot memory report after changing task code
+#define MPU_TASK_STACK          4096
+#define TELEMETRY_TASK_STACK    4096
+#define MAG_TASK_STACK          2048
+#define SPECTRUM_TASK_STACK     4096
+
+// The rate loop runs on every Nth data-ready
+#define MPU_SAMPLES_PER_CYCLE   (MPU6500_SAMPLE_RATE_HZ * RATE_LOOP_PERIOD_US / 1000000)
+
+// Accel samples buffered for spectrum analysis; only has to ride out one
+// analyze() call and preemption by higher priority tasks
+#define SPECTRUM_QUEUE_LEN      64
+#define SPECTRUM_BENCH_ITERS    20
+
+// FIFO samples drained per rate loop cycle. Two arrive per cycle; the slack
+// catches up after a late cycle without one long bus transfer.
+#define SPECTRUM_FIFO_BATCH     4
+
+// IMU mounting: body axis i (FRD: x forward, y right, z down) is
+// imu_body_sign[i] times sensor axis imu_body_axis[i]. The MPU6500 sits
+// component side up with its x axis towards the nose, so y and z flip.
+static const int imu_body_axis[3] = { 0, 1, 2 };
+static const float imu_body_sign[3] = { 1.0f, -1.0f, -1.0f };
+
+struct ImuSample {
+    int64_t t_us;
+    float accel[3];     // g, body frame
+    float gyro[3];      // rad/s, body frame
+    float attitude[3];  // rad, roll/pitch/yaw
+};
+
+// One FIFO accel sample. seq advances for every sample, delivered or not,
+// so the spectrum task can tell a gap from a continuous stream.
+struct VibrationSample {
+    uint32_t seq;
+    float accel[3];     // g, body frame
+};
+
+// Payload of a stats frame
+struct TelemetryStats {
+    RateLoopStats loop;
+    uint32_t vibration_drops;   // Accel samples lost before spectrum analysis
+};
 
 // Global variables
 static const char *TAG = "main";
+static MPU6500 mpu(MPU6500_I2C_ADDR);
+static LedcActuator motors;
+static RateLoop rate_loop(&motors);
+static AttitudeEstimator attitude;
+static VibrationAnalyzer vibration(MPU6500_SAMPLE_RATE_HZ);
+static volatile int64_t mpu_sample_us = 0;
+static uint32_t mpu_ready_count = 0;
+
+// Running total of vibration samples lost, written by the spectrum task
+static std::atomic<uint32_t> vibration_drops{0};
+
+// Latest sample, overwritten every cycle
+static QueueHandle_t imu_mailbox = NULL;
+static StaticQueue_t imu_mailbox_buf;
+static uint8_t imu_mailbox_storage[sizeof(ImuSample)];
+
+// Every FIFO accel sample, in order, for spectrum analysis
+static QueueHandle_t vibration_queue = NULL;
+static StaticQueue_t vibration_queue_buf;
+static uint8_t vibration_queue_storage[SPECTRUM_QUEUE_LEN * sizeof(VibrationSample)];
+
+// Statically allocated tasks
+static TaskHandle_t mpu_task_handle = NULL;
+static StaticTask_t mpu_task_tcb;
+static StackType_t mpu_task_stack[MPU_TASK_STACK];
+
+static TaskHandle_t telemetry_task_handle = NULL;
+static StaticTask_t telemetry_task_tcb;
+static StackType_t telemetry_task_stack[TELEMETRY_TASK_STACK];
+
+static TaskHandle_t mag_task_handle = NULL;
+static StaticTask_t mag_task_tcb;
+static StackType_t mag_task_stack[MAG_TASK_STACK];
+
+static TaskHandle_t spectrum_task_handle = NULL;
+static StaticTask_t spectrum_task_tcb;
+static StackType_t spectrum_task_stack[SPECTRUM_TASK_STACK];
+
+// Linker symbols bounding internal RAM .data and .bss
+extern int _data_start, _data_end, _bss_start, _bss_end;
+
+// MPU6500 data-ready: timestamp the sample and wake the rate loop on every
+// MPU_SAMPLES_PER_CYCLE-th one. The samples in between only feed the FIFO.
+static void IRAM_ATTR mpu_data_ready_isr(void *arg) {
+    if (++mpu_ready_count % MPU_SAMPLES_PER_CYCLE != 0) {
+        return;
+    }
+    mpu_sample_us = esp_timer_get_time();
+
+    BaseType_t higher_priority_woken = pdFALSE;
+    if (mpu_task_handle != NULL) {
+        vTaskNotifyGiveFromISR(mpu_task_handle, &higher_priority_woken);
+    }
+    portYIELD_FROM_ISR(higher_priority_woken);
+}
+
+// Rotate a sensor-frame vector into the body frame in place
+static void sensor_to_body(float v[3]) {
+    float sensor[3] = { v[0], v[1], v[2] };
+    for (int i = 0; i < 3; i++) {
+        v[i] = imu_body_sign[i] * sensor[imu_body_axis[i]];
+    }
+}
+
+// Clock the rate loop from the MPU data-ready line. Called from the rate loop
+// task so the GPIO interrupt is allocated on the app core with it.
+static esp_err_t mpu_data_ready_init(void) {
+    gpio_config_t int_cfg = {};
+    int_cfg.pin_bit_mask = 1ULL << MPU6500_INT_IO;
+    int_cfg.mode = GPIO_MODE_INPUT;
+    int_cfg.intr_type = GPIO_INTR_POSEDGE;
+    esp_err_t err = gpio_config(&int_cfg);
+    if (err != ESP_OK) return err;
 
+    err = gpio_install_isr_service(ESP_INTR_FLAG_IRAM);
+    if (err != ESP_OK) return err;
+
+    err = gpio_isr_handler_add((gpio_num_t)MPU6500_INT_IO, mpu_data_ready_isr, NULL);
+    if (err != ESP_OK) return err;
+
+    err = mpu.enable_accel_fifo();
+    if (err != ESP_OK) return err;
+
+    return mpu.enable_data_ready_interrupt();
+}
+
+// Rate loop task, clocked by IMU data-ready at RATE_LOOP_PERIOD_US
 void mpu_reader_task(void *arg) {
-    MPU6500 *mpu = static_cast<MPU6500*>(arg);
+    // The I2C driver allocates its interrupt on the calling core, so the bus
+    // is brought up here rather than in app_main on the protocol core
+    esp_err_t err = i2c_manager_init();
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "I2C initialization failed: %s", esp_err_to_name(err));
+        vTaskDelete(NULL);
+    }
+
+    err = mpu.init(i2c_manager_get_bus_handle());
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "MPU initialization failed: %s", esp_err_to_name(err));
+        vTaskDelete(NULL);
+    }
+
+    err = mpu_data_ready_init();
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "MPU data-ready setup failed: %s", esp_err_to_name(err));
+        vTaskDelete(NULL);
+    }
+
+    uint32_t vibration_seq = 0;
+
+    while (1) {
+        if (ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(IMU_TIMEOUT_MS)) == 0) {
+            rate_loop.note_missed_sample(esp_timer_get_time());
+            continue;
+        }
+
+        ImuSample sample;
+        sample.t_us = mpu_sample_us;
+        esp_err_t result = mpu.read_data(&sample.accel[0], &sample.accel[1], &sample.accel[2],
+                                         &sample.gyro[0], &sample.gyro[1], &sample.gyro[2]);
+        if (result != ESP_OK) {
+            // Counted, not logged: a UART write here would stall the loop
+            rate_loop.note_read_error(sample.t_us);
+            continue;
+        }
+        // Everything downstream works in the body frame
+        sensor_to_body(sample.accel);
+        sensor_to_body(sample.gyro);
+
+        rate_loop.step(sample.gyro, sample.t_us);
+        rate_loop.end_cycle(esp_timer_get_time());
+
+        attitude.update(sample.accel, sample.gyro, RATE_LOOP_PERIOD_US * 1e-6f);
+        attitude.get(sample.attitude);
+
+        // Hand off to telemetry without ever blocking the loop
+        xQueueOverwrite(imu_mailbox, &sample);
+
+        // The 1 kHz accel stream for spectrum analysis is drained after the
+        // actuator write, so it never adds to control latency
+        float fifo[SPECTRUM_FIFO_BATCH][3];
+        size_t count = 0;
+        if (mpu.read_accel_fifo(fifo, SPECTRUM_FIFO_BATCH, &count) != ESP_OK) {
+            // Overflowed or a failed read: at least one sample is gone
+            vibration_seq++;
+        }
+        for (size_t i = 0; i < count; i++) {
+            // A full queue loses the sample, and the skipped seq says so
+            VibrationSample vib;
+            vib.seq = vibration_seq++;
+            memcpy(vib.accel, fifo[i], sizeof(vib.accel));
+            sensor_to_body(vib.accel);
+            xQueueSend(vibration_queue, &vib, 0);
+        }
+    }
+
+    vTaskDelete(NULL);
+}
+
+// Build a telemetry frame into out, returns its length
+static size_t encode_frame(uint8_t flags, const void *payload, size_t len, uint8_t *out) {
+    out[0] = FRAME_SYNC;
+    out[1] = flags;
+    memcpy(&out[2], payload, len);
+    return len + 2;
+}
+
+// Telemetry task, encodes each stream once and hands it to the server for
+// fan-out to all subscribers
+void telemetry_task(void *arg) {
     TickType_t xLastWakeTime = xTaskGetTickCount();
-    
+    TickType_t last_stats = xLastWakeTime;
+    int64_t last_sample_us = 0;
+    uint32_t tick = 0;
+
+    // Counters accumulated over LOOP_STATS_INTERVAL_MS for the log
+    RateLoopStats log_window = {};
+    log_window.min_period_us = UINT32_MAX;
+    uint32_t log_drops = 0;
+    uint32_t last_drops = vibration_drops.load();
+    rate_loop.request_stats();
+
     while (1) {
-        float ax, ay, az, gx, gy, gz;
-        esp_err_t result = mpu->read_data(&ax, &ay, &az, &gx, &gy, &gz);
-        if (result == ESP_OK) {
-            // Invert accel z axis 
-            az = -az;
-            // Create binary message
-            uint8_t message[26]; // 1 sync + 1 flags + 24 data bytes (6 floats * 4 bytes)
-            size_t msg_size = 0;
-            
-            // Sync byte
-            message[msg_size++] = 0xAA;
-            
-            // Flags byte (0x03 = accel + gyro bits set)
-            message[msg_size++] = 0x03; // 0x02 (accel) | 0x01 (gyro)
-            
-            // Data payload - accel first, then gyro
-            // Convert floats to bytes (little endian)
-            memcpy(&message[msg_size], &ax, 4); msg_size += 4;
-            memcpy(&message[msg_size], &ay, 4); msg_size += 4;
-            memcpy(&message[msg_size], &az, 4); msg_size += 4;
-            memcpy(&message[msg_size], &gx, 4); msg_size += 4;
-            memcpy(&message[msg_size], &gy, 4); msg_size += 4;
-            memcpy(&message[msg_size], &gz, 4); msg_size += 4;
-            
-            // Send binary data over web socket
-            ws_client_send_binary(message, msg_size);
-        } else {
-            ESP_LOGE(TAG, "MPU read error: %s", esp_err_to_name(result));
+        uint8_t frame[TELEM_MAX_FRAME_LEN];
+        size_t len;
+
+        // Streams nobody is subscribed to are not encoded at all
+        ImuSample sample;
+        if (xQueuePeek(imu_mailbox, &sample, 0) == pdTRUE && sample.t_us != last_sample_us) {
+            last_sample_us = sample.t_us;
+
+            if (telemetry_server_has_subscribers(TELEM_STREAM_IMU)) {
+                // Accel first, then gyro, as 6 floats
+                float imu[6];
+                memcpy(&imu[0], sample.accel, sizeof(sample.accel));
+                memcpy(&imu[3], sample.gyro, sizeof(sample.gyro));
+                len = encode_frame(FRAME_FLAG_ACCEL | FRAME_FLAG_GYRO, imu, sizeof(imu), frame);
+                telemetry_server_publish(TELEM_STREAM_IMU, frame, len);
+            }
+
+            if (telemetry_server_has_subscribers(TELEM_STREAM_ATTITUDE)) {
+                len = encode_frame(FRAME_FLAG_ATTITUDE, sample.attitude, sizeof(sample.attitude), frame);
+                telemetry_server_publish(TELEM_STREAM_ATTITUDE, frame, len);
+            }
         }
-        
-        vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(10)); // 100Hz
+
+        // The loop task hands over and clears its counters; never touch them from
+        // here. Polled regardless of subscribers, the log window needs them too.
+        TelemetryStats stats;
+        if (++tick % TELEMETRY_STATS_DIV == 0 && rate_loop.poll_stats(stats.loop)) {
+            uint32_t drops = vibration_drops.load();
+            stats.vibration_drops = drops - last_drops;
+            last_drops = drops;
+
+            if (telemetry_server_has_subscribers(TELEM_STREAM_STATS)) {
+                len = encode_frame(FRAME_FLAG_STATS, &stats, sizeof(stats), frame);
+                telemetry_server_publish(TELEM_STREAM_STATS, frame, len);
+            }
+            rate_loop_stats_merge(log_window, stats.loop);
+            log_drops += stats.vibration_drops;
+            rate_loop.request_stats();
+        }
+
+        if (xTaskGetTickCount() - last_stats >= pdMS_TO_TICKS(LOOP_STATS_INTERVAL_MS)) {
+            const RateLoopStats &w = log_window;
+            ESP_LOGI(TAG, "Rate loop: %lu cycles, %lu overruns, %lu missed, %lu read errors, %lu failsafes, latency %lu/%lu us, period %lu-%lu us, %lu vibration drops, %d clients",
+                     (unsigned long)w.cycles, (unsigned long)w.overruns,
+                     (unsigned long)w.missed_samples, (unsigned long)w.read_errors,
+                     (unsigned long)w.failsafes, (unsigned long)w.last_latency_us,
+                     (unsigned long)w.max_latency_us, (unsigned long)w.min_period_us,
+                     (unsigned long)w.max_period_us, (unsigned long)log_drops,
+                     telemetry_server_client_count());
+            log_window = {};
+            log_window.min_period_us = UINT32_MAX;
+            log_drops = 0;
+            last_stats = xTaskGetTickCount();
+        }
+
+        vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(TELEMETRY_PERIOD_MS));
     }
-    
-    // Cleanup (should never reach here)
-    delete mpu;
+
+    vTaskDelete(NULL);
+}
+
+// Vibration spectrum task, runs windowed FFTs over every FIFO accel sample and
+// streams compact per-axis summaries instead of raw data
+void spectrum_task(void *arg) {
+#if CONFIG_SPECTRUM_BOOT_SELF_TEST
+    float error = spectrum_self_test(vibration, MPU6500_SAMPLE_RATE_HZ);
+    float cost_us = spectrum_benchmark(vibration, SPECTRUM_BENCH_ITERS);
+    ESP_LOGI(TAG, "Spectrum: %d-point FFT, max error vs reference %.2e, %.0f us per window",
+             SPECTRUM_FFT_SIZE, error, cost_us);
+    vibration.reset();
+    xQueueReset(vibration_queue);
+#endif
+
+    // Primed from the first sample, so samples discarded above are not drops
+    bool primed = false;
+    uint32_t expected_seq = 0;
+    while (1) {
+        VibrationSample vib;
+        xQueueReceive(vibration_queue, &vib, portMAX_DELAY);
+
+        // Never splice across a gap: count what was lost and start a new window
+        if (primed && vib.seq != expected_seq) {
+            vibration_drops.fetch_add(vib.seq - expected_seq);
+            vibration.reset();
+        }
+        expected_seq = vib.seq + 1;
+        primed = true;
+
+        // Keep the window filling so a new subscriber gets a spectrum within a hop
+        if (!vibration.push(vib.accel) || !telemetry_server_has_subscribers(TELEM_STREAM_SPECTRUM)) {
+            continue;
+        }
+
+        SpectrumSummary summary;
+        vibration.analyze(summary);
+
+        uint8_t payload[SPECTRUM_ENCODED_LEN];
+        uint8_t frame[TELEM_MAX_FRAME_LEN];
+        size_t len = spectrum_encode(summary, payload);
+        len = encode_frame(FRAME_FLAG_SPECTRUM, payload, len, frame);
+        telemetry_server_publish(TELEM_STREAM_SPECTRUM, frame, len);
+    }
+
     vTaskDelete(NULL);
 }
 
@@ -75,9 +394,58 @@ void mag_reader_task(void *arg) {
     vTaskDelete(NULL);
 }
 
+// Log heap, static RAM and per-task stack usage once everything is running
+static void log_memory_report(void) {
+    const struct {
+        const char *name;
+        TaskHandle_t handle;
+        size_t stack_size;
+        bool is_static;     // Stack and TCB live in .bss
+    } tasks[] = {
+        { "mpu_reader",   mpu_task_handle,                MPU_TASK_STACK,                  true },
+        { "telemetry",    telemetry_task_handle,          TELEMETRY_TASK_STACK,            true },
+        { "mag_reader",   mag_task_handle,                MAG_TASK_STACK,                  true },
+        { "spectrum",     spectrum_task_handle,           SPECTRUM_TASK_STACK,             true },
+        { "telem_sender", telemetry_server_task_handle(), TELEM_TASK_STACK,                true },
+        { "main",         xTaskGetCurrentTaskHandle(),    CONFIG_ESP_MAIN_TASK_STACK_SIZE, false },
+    };
+
+    size_t data_size = (uint8_t *)&_data_end - (uint8_t *)&_data_start;
+    size_t bss_size = (uint8_t *)&_bss_end - (uint8_t *)&_bss_start;
+    size_t task_static = 0;
+    for (const auto &task : tasks) {
+        if (task.is_static) {
+            task_static += task.stack_size + sizeof(StaticTask_t);
+        }
+    }
+
+    ESP_LOGI(TAG, "Static RAM: .data %u B, .bss %u B (task stacks and TCBs %u B)",
+             (unsigned)data_size, (unsigned)bss_size, (unsigned)task_static);
+    ESP_LOGI(TAG, "Heap: %u of %u B free, %u B min free, %u B largest block",
+             (unsigned)heap_caps_get_free_size(MALLOC_CAP_8BIT),
+             (unsigned)heap_caps_get_total_size(MALLOC_CAP_8BIT),
+             (unsigned)heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT),
+             (unsigned)heap_caps_get_largest_free_block(MALLOC_CAP_8BIT));
+
+    for (const auto &task : tasks) {
+        // A NULL handle would report the calling task instead
+        if (task.handle == NULL) {
+            ESP_LOGW(TAG, "Stack %-12s: not running", task.name);
+            continue;
+        }
+        UBaseType_t unused = uxTaskGetStackHighWaterMark(task.handle);
+        ESP_LOGI(TAG, "Stack %-12s: %u of %u B used",
+                 task.name, (unsigned)(task.stack_size - unused), (unsigned)task.stack_size);
+    }
+}
+
 extern "C" void app_main() {
     ESP_LOGI(TAG, "Starting application...");
 
+    // Motors off before anything else can stall boot
+    ESP_ERROR_CHECK(motors.init());
+    motors.disarm();
+
     // Initialize nvs flash and WiFi
     nvs_flash_init();
     ESP_LOGI(TAG, "Initializing WiFi...");
@@ -86,49 +454,53 @@ extern "C" void app_main() {
         ESP_LOGE(TAG, "WiFi initialization failed, continuing without WiFi");
     }
 
-    // Initialize web socket client
-    ESP_LOGI(TAG, "Initializing web socket client...");
-    ws_client_start();
-
-    // Initialize I2C
-    ESP_ERROR_CHECK(i2c_manager_init());
-    
-    // Initialize MPU on heap
-    i2c_master_bus_handle_t bus_handle = i2c_manager_get_bus_handle();
-    MPU6500* mpu = new MPU6500(0x68);
-    esp_err_t err = mpu->init(bus_handle);
-    if (err != ESP_OK) {
-        ESP_LOGE(TAG, "MPU initialization failed: %s", esp_err_to_name(err));
-        delete mpu;
-        return;
+    // Start telemetry server, clients find it as esp-drone.local
+    ESP_LOGI(TAG, "Starting telemetry server...");
+    if (telemetry_server_start() != ESP_OK) {
+        ESP_LOGE(TAG, "Telemetry server failed to start, continuing without telemetry");
     }
 
+    imu_mailbox = xQueueCreateStatic(1, sizeof(ImuSample), imu_mailbox_storage, &imu_mailbox_buf);
+    vibration_queue = xQueueCreateStatic(SPECTRUM_QUEUE_LEN, sizeof(VibrationSample),
+                                         vibration_queue_storage, &vibration_queue_buf);
+
     // Create MPU reader task
-    BaseType_t task_result = xTaskCreate(
+    mpu_task_handle = xTaskCreateStaticPinnedToCore(
         mpu_reader_task,        "mpu_reader",
-        5120,                   mpu,
-        3,                      NULL   // High priority
-    ); 
-    if (task_result != pdPASS) {
-        ESP_LOGE(TAG, "MPU reader task creation failed!");
-        delete mpu;
-        return;
-    }
+        MPU_TASK_STACK,         NULL,
+        5,                      mpu_task_stack,
+        &mpu_task_tcb,          APP_CORE   // Highest priority, runs the rate loop
+    );
+
+    // Create telemetry task next to the network stack it feeds
+    telemetry_task_handle = xTaskCreateStaticPinnedToCore(
+        telemetry_task,         "telemetry",
+        TELEMETRY_TASK_STACK,   NULL,
+        3,                      telemetry_task_stack,
+        &telemetry_task_tcb,    PROTOCOL_CORE   // High priority
+    );
 
     // Create magnetometer reader task
-    task_result = xTaskCreate(
+    mag_task_handle = xTaskCreateStaticPinnedToCore(
         mag_reader_task,        "mag_reader",
-        4096,                   NULL,
-        2,                      NULL   // Medium priority
+        MAG_TASK_STACK,         NULL,
+        2,                      mag_task_stack,
+        &mag_task_tcb,          APP_CORE   // Medium priority
     );
-    if (task_result != pdPASS) {
-        ESP_LOGE(TAG, "Mag reader task creation failed!");
-        delete mpu;
-        return;
-    }
 
-    // Main loop
-    while(1){
-        vTaskDelay(1000);
-    }
-}
\ No newline at end of file
+    // Create spectrum task below everything else on the app core, so the
+    // rate loop always preempts the FFTs
+    spectrum_task_handle = xTaskCreateStaticPinnedToCore(
+        spectrum_task,          "spectrum",
+        SPECTRUM_TASK_STACK,    NULL,
+        1,                      spectrum_task_stack,
+        &spectrum_task_tcb,     APP_CORE   // Low priority
+    );
+
+    // Let the tasks run once before measuring them
+    vTaskDelay(pdMS_TO_TICKS(100));
+    log_memory_report();
+
+    // Returning deletes the main task and frees its stack
+    ESP_LOGI(TAG, "Startup complete");
+}